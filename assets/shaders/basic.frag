@@ -4,10 +4,16 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec3 VertexColor;
 
-uniform vec3 uLightPos;
-uniform vec3 uViewPos;
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
 uniform vec3 uObjectColor;
-uniform vec3 uLightColor;
 uniform bool uUseVertexColor;
 
 out vec4 FragColor;
@@ -4,9 +4,16 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec3 aColor;
 
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 
 out vec3 FragPos;
 out vec3 Normal;
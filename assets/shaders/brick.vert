@@ -0,0 +1,34 @@
+#version 330 core
+
+// 共享单位立方体
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// 逐砖实例数据
+layout (location = 2) in vec3 aMinCorner;
+layout (location = 3) in vec3 aExtent;
+layout (location = 4) in uint aColorIndex;
+
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
+uniform vec3 uBrickPalette[2];
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 VertexColor;
+
+void main()
+{
+    // 砖块为轴对齐长方体，缩放不改变轴向法线
+    FragPos = aMinCorner + aPos * aExtent;
+    Normal = aNormal;
+    VertexColor = uBrickPalette[aColorIndex];
+
+    gl_Position = uProjection * uView * vec4(FragPos, 1.0);
+}
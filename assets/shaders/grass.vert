@@ -1,12 +1,27 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec3 aColor;
+// 压缩地形顶点：块内 16 位定点坐标 + (法线索引, 地形类型)
+layout (location = 0) in vec3 aPackedPos;
+layout (location = 1) in uvec2 aNormalType;
+
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+uniform vec3 uChunkOrigin;
+uniform float uPositionScale;
+
+const vec3 NORMALS[6] = vec3[6](
+    vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+    vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0)
+);
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -14,6 +29,8 @@ out vec3 WorldPos;
 
 void main()
 {
+    vec3 aPos = uChunkOrigin + aPackedPos * uPositionScale;
+    vec3 aNormal = NORMALS[aNormalType.x];
     FragPos = vec3(uModel * vec4(aPos, 1.0));
     WorldPos = FragPos;
     Normal = mat3(transpose(inverse(uModel))) * aNormal;
@@ -0,0 +1,32 @@
+#version 330 core
+
+// 基础几何体（立方体/圆锥/圆柱/球）
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// 逐部件实例数据：颜色 + 模型矩阵（mat4 占 3~6 四个位置）
+layout (location = 2) in vec3 aInstanceColor;
+layout (location = 3) in mat4 aInstanceModel;
+
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 VertexColor;
+
+void main()
+{
+    FragPos = vec3(aInstanceModel * vec4(aPos, 1.0));
+
+    // 部件有非均匀缩放，仍需法线矩阵
+    Normal = mat3(transpose(inverse(aInstanceModel))) * aNormal;
+    VertexColor = aInstanceColor;
+
+    gl_Position = uProjection * uView * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,39 @@
+#version 330 core
+
+// 压缩地形顶点：块内 16 位定点坐标 + (法线索引, 地形类型)
+layout (location = 0) in vec3 aPackedPos;
+layout (location = 1) in uvec2 aNormalType;
+
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
+uniform mat4 uModel;
+uniform vec3 uChunkOrigin;
+uniform float uPositionScale;
+uniform vec3 uTerrainPalette[4];
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 VertexColor;
+
+const vec3 NORMALS[6] = vec3[6](
+    vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0),
+    vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0)
+);
+
+void main()
+{
+    vec3 localPos = uChunkOrigin + aPackedPos * uPositionScale;
+    FragPos = vec3(uModel * vec4(localPos, 1.0));
+    Normal = mat3(transpose(inverse(uModel))) * NORMALS[aNormalType.x];
+    VertexColor = uTerrainPalette[aNormalType.y];
+
+    gl_Position = uProjection * uView * vec4(FragPos, 1.0);
+}
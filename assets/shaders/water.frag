@@ -4,22 +4,49 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 UV;
 in float Height;
+in vec2 MaskPos;
+
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
 
-uniform vec3 uViewPos;
-uniform vec3 uWaterColor;
-uniform vec3 uLightDir;
 uniform float uTime;
 
-uniform int uUseBoatCutout;
-uniform vec3 uBoatPos;
-uniform float uBoatCutoutInner;
-uniform float uBoatCutoutOuter;
+// 波浪、颜色、光照、船只裁剪参数（std140，与 WaterSurface::ParamsBlock 一一对应，water.vert/water.frag 中声明一致）
+struct Wave {
+    vec2 direction;
+    float amplitude;
+    float wavelength;
+    float speed;
+    float steepness;
+};
+
+layout(std140) uniform WaterParams {
+    Wave uWaves[64];            // 16 组，每组 4 个；第 0 组为默认波浪，第 k 组属于水域 k
+    ivec4 uWaveCounts[4];       // 第 k 组的波浪数为 uWaveCounts[k / 4][k % 4]
+    int uUseBoatCutout;
+    int uBoatCutoutShape;       // 0=circle, 1=OBB(rect) in XZ
+    float uBoatCutoutInner;
+    float uBoatCutoutOuter;
+    vec3 uWaterColor;
+    float uBoatCutoutFeather;
+    vec3 uLightDir;
+    vec3 uBoatPos;
+    vec2 uBoatForwardXZ;
+    vec2 uBoatHalfExtentsXZ;
+};
 
-// 0=circle, 1=OBB(rect) in XZ
-uniform int uBoatCutoutShape;
-uniform vec2 uBoatForwardXZ;
-uniform vec2 uBoatHalfExtentsXZ;
-uniform float uBoatCutoutFeather;
+// 逐格水域遮罩（R8，非 0 为水）
+uniform int uUseWaterMask;
+uniform sampler2D uWaterMask;
+uniform vec2 uMaskOrigin;
+uniform float uMaskCellSize;
+uniform int uMaskGridSize;
 
 out vec4 FragColor;
 
@@ -33,6 +60,17 @@ float fresnelSchlick(float cosTheta, float F0) {
 }
 
 void main() {
+    // 非水格子直接丢弃（遮罩以外视为无水）
+    if (uUseWaterMask == 1) {
+        ivec2 cell = ivec2(floor((MaskPos - uMaskOrigin) / uMaskCellSize));
+        if (any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(cell, ivec2(uMaskGridSize)))) {
+            discard;
+        }
+        if (texelFetch(uWaterMask, cell, 0).r < 0.5) {
+            discard;
+        }
+    }
+
     // 船只附近水面裁剪：避免水出现在船板/船舱视线里
     float cutoutMask = 1.0;
     if (uUseBoatCutout == 1) {
@@ -3,12 +3,19 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aUV;
 
+// 每帧参数（std140，与 FrameUniforms::Block 一一对应，所有着色器中声明一致）
+layout(std140) uniform FrameUniforms {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    vec3 uLightPos;
+    vec3 uLightColor;
+};
+
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 uniform float uTime;
 
-// Gerstner Wave 参数
+// 波浪、颜色、光照、船只裁剪参数（std140，与 WaterSurface::ParamsBlock 一一对应，water.vert/water.frag 中声明一致）
 struct Wave {
     vec2 direction;
     float amplitude;
@@ -17,31 +24,87 @@ struct Wave {
     float steepness;
 };
 
-uniform int uWaveCount;
-uniform Wave uWaves[4];
+layout(std140) uniform WaterParams {
+    Wave uWaves[64];            // 16 组，每组 4 个；第 0 组为默认波浪，第 k 组属于水域 k
+    ivec4 uWaveCounts[4];       // 第 k 组的波浪数为 uWaveCounts[k / 4][k % 4]
+    int uUseBoatCutout;
+    int uBoatCutoutShape;       // 0=circle, 1=OBB(rect) in XZ
+    float uBoatCutoutInner;
+    float uBoatCutoutOuter;
+    vec3 uWaterColor;
+    float uBoatCutoutFeather;
+    vec3 uLightDir;
+    vec3 uBoatPos;
+    vec2 uBoatForwardXZ;
+    vec2 uBoatHalfExtentsXZ;
+};
+
+// FFT 海浪参数（uWaveModel = 1 时使用）
+uniform int uWaveModel;                 // 0 = Gerstner，1 = FFT 海浪
+uniform sampler2D uOceanDisplacement;   // (dx, h, dz)，平铺周期 uOceanPatchSize
+uniform sampler2D uOceanNormal;
+uniform float uOceanPatchSize;
+
+// 跟随相机的 LOD 网格（uUseClipmap = 1 时 aPos.xz 为本层格点编号）
+uniform int uUseClipmap;
+uniform vec2 uClipmapOrigin;       // 本层 (0, 0) 格点的世界 XZ
+uniform float uClipmapSpacing;     // 本层格子间距
+uniform vec2 uClipmapMorphRange;   // 过渡开始/结束的切比雪夫距离
+uniform vec2 uClipmapCenter;       // 各层围绕的中心 XZ
+uniform vec2 uClipmapBoundsMin;    // 水面范围，超出部分压到边界上（退化为零面积三角形）
+uniform vec2 uClipmapBoundsMax;
+
+// 逐格水域编号（uUseWaterRegions = 1 时按编号选择波浪组，否则全部使用第 0 组）
+uniform int uUseWaterRegions;
+uniform sampler2D uWaterRegions;   // R8，编号 / 255
+uniform vec2 uRegionOrigin;
+uniform float uRegionCellSize;
+uniform int uRegionGridSize;
+
+// 船只尾迹高度场（uUseWake = 1 时叠加到波浪位移上）
+uniform int uUseWake;
+uniform sampler2D uWakeHeight;     // R32F，窗口外为 0
+uniform vec2 uWakeOrigin;          // 窗口 (0, 0) 格子的世界 XZ
+uniform float uWakeSize;           // 窗口边长
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 UV;
 out float Height;
+out vec2 MaskPos;   // 未受波浪水平偏移影响的世界 XZ，用于水域遮罩查询
 
 const float PI = 3.14159265359;
 
-// 计算 Gerstner Wave
-vec3 calculateGerstnerWave(vec3 pos) {
+// 顶点所在水域的波浪组：取最近格点周围 4 个格子中的编号（与 WaterSurface::getWaveSetAt 一致）
+int waveSetAt(vec2 pos) {
+    if (uUseWaterRegions == 0) return 0;
+    ivec2 corner = ivec2(floor((pos - uRegionOrigin) / uRegionCellSize + 0.5));
+    int set = 0;
+    for (int dz = -1; dz <= 0; dz++) {
+        for (int dx = -1; dx <= 0; dx++) {
+            ivec2 cell = clamp(corner + ivec2(dx, dz), ivec2(0), ivec2(uRegionGridSize - 1));
+            set = max(set, int(texelFetch(uWaterRegions, cell, 0).r * 255.0 + 0.5));
+        }
+    }
+    return set;
+}
+
+// 计算 Gerstner Wave（使用第 waveSet 组波浪）
+vec3 calculateGerstnerWave(vec3 pos, int waveSet) {
     vec3 result = pos;
     vec3 tangent = vec3(1.0, 0.0, 0.0);
     vec3 binormal = vec3(0.0, 0.0, 1.0);
     
-    for (int i = 0; i < uWaveCount && i < 4; i++) {
-        Wave wave = uWaves[i];
+    int waveCount = uWaveCounts[waveSet / 4][waveSet % 4];
+    for (int i = 0; i < waveCount && i < 4; i++) {
+        Wave wave = uWaves[waveSet * 4 + i];
         
         float k = 2.0 * PI / wave.wavelength;
         float c = wave.speed;
         vec2 d = normalize(wave.direction);
         float f = k * (dot(d, pos.xz) - c * uTime);
         float a = wave.amplitude;
-        float q = wave.steepness / (k * a * float(uWaveCount));
+        float q = wave.steepness / (k * a * float(waveCount));
         
         // Gerstner Wave 位置偏移
         result.x += q * a * d.x * cos(f);
@@ -69,13 +132,61 @@ vec3 calculateGerstnerWave(vec3 pos) {
     return result;
 }
 
+// 格点编号换算到世界 XZ；靠近本层外缘时奇数格点并到相邻偶数格点，与外层网格重合
+vec2 clipmapPosition(vec2 gridPos) {
+    vec2 world = uClipmapOrigin + gridPos * uClipmapSpacing;
+    vec2 delta = abs(world - uClipmapCenter);
+    float morph = clamp((max(delta.x, delta.y) - uClipmapMorphRange.x)
+                        / (uClipmapMorphRange.y - uClipmapMorphRange.x), 0.0, 1.0);
+    world -= fract(gridPos * 0.5) * 2.0 * uClipmapSpacing * morph;
+    return clamp(world, uClipmapBoundsMin, uClipmapBoundsMax);
+}
+
+// 采样 FFT 海浪纹理（采样点 (i, j) 位于纹素中心，因此偏移半个纹素）
+vec3 sampleOceanWave(vec3 pos) {
+    vec2 uv = pos.xz / uOceanPatchSize + 0.5 / vec2(textureSize(uOceanDisplacement, 0));
+    vec3 displacedPos = pos + textureLod(uOceanDisplacement, uv, 0.0).xyz;
+    
+    Normal = normalize(textureLod(uOceanNormal, uv, 0.0).xyz);
+    Height = displacedPos.y;
+    
+    return displacedPos;
+}
+
+// 叠加尾迹高度，并用中心差分的坡度修正法线
+vec3 applyWake(vec2 gridXZ, vec3 displacedPos) {
+    vec2 texelCount = vec2(textureSize(uWakeHeight, 0));
+    vec2 uv = (gridXZ - uWakeOrigin) / uWakeSize + 0.5 / texelCount;
+    float h = textureLod(uWakeHeight, uv, 0.0).r;
+    float dhdx = textureLodOffset(uWakeHeight, uv, 0.0, ivec2(1, 0)).r
+               - textureLodOffset(uWakeHeight, uv, 0.0, ivec2(-1, 0)).r;
+    float dhdz = textureLodOffset(uWakeHeight, uv, 0.0, ivec2(0, 1)).r
+               - textureLodOffset(uWakeHeight, uv, 0.0, ivec2(0, -1)).r;
+    vec2 slope = vec2(dhdx, dhdz) * texelCount.x / (2.0 * uWakeSize);
+    
+    Normal = normalize(Normal - vec3(slope.x, 0.0, slope.y));
+    displacedPos.y += h;
+    Height = displacedPos.y;
+    return displacedPos;
+}
+
 void main() {
     // 计算波浪变形后的位置
-    vec3 worldPos = vec3(uModel * vec4(aPos, 1.0));
-    vec3 displacedPos = calculateGerstnerWave(worldPos);
+    vec3 localPos = aPos;
+    vec2 uv = aUV;
+    if (uUseClipmap == 1) {
+        localPos.xz = clipmapPosition(aPos.xz);
+        uv = (localPos.xz - uClipmapBoundsMin) / (uClipmapBoundsMax - uClipmapBoundsMin);
+    }
+    vec3 worldPos = vec3(uModel * vec4(localPos, 1.0));
+    MaskPos = worldPos.xz;
+    vec3 displacedPos = (uWaveModel == 1) ? sampleOceanWave(worldPos) : calculateGerstnerWave(worldPos, waveSetAt(worldPos.xz));
+    if (uUseWake == 1) {
+        displacedPos = applyWake(worldPos.xz, displacedPos);
+    }
     
     FragPos = displacedPos;
-    UV = aUV;
+    UV = uv;
     
     gl_Position = uProjection * uView * vec4(displacedPos, 1.0);
 }
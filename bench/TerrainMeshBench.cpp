@@ -0,0 +1,605 @@
+/**
+ * @brief 地形/水面网格生成基准（无需 GL 上下文，可在无 GPU 的 CI 机器上运行）
+ *
+ * 用法：TerrainMeshBench [迭代次数] [网格边长...]
+ * 默认迭代 5 次，网格边长 128 320 640 1024。
+ * 对每种布局 × 网格大小输出：耗时（最短/平均，毫秒）、顶点数、字节数；
+ * 最后输出水面高度批量查询与逐点标量计算的对比，并把批量查询与 water.vert 的 CPU 移植对照校验、
+ * 把高度场缓存的插值结果与直接求值对照校验（误差超出容差时返回非 0）。
+ */
+
+#include "Editor/SceneEditor.h"
+#include "Editor/TerrainMap.h"
+#include "Render/TerrainMesher.h"
+#include "Water/WaterMeshBuilder.h"
+#include "Water/GerstnerSampler.h"
+#include "Water/OceanSpectrum.h"
+#include "Water/WakeSimulation.h"
+#include "Water/WaveHeightfield.h"
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace WaterTown;
+
+namespace {
+
+/**
+ * @brief 单项测量结果
+ */
+struct BenchResult {
+    double bestMs = 0.0;
+    double averageMs = 0.0;
+    size_t vertexCount = 0;
+    size_t instanceCount = 0;
+    size_t bytes = 0;
+};
+
+// ===== 测试布局 =====
+
+void buildDefaultLayout(TerrainMap& map) {
+    int riverStart, riverEnd;
+    map.generateDefaultLayout(riverStart, riverEnd);
+}
+
+// 逐格随机（草地/水/石路），相邻格几乎都不同类型，是贪心合并和河岸墙的最坏情况
+void buildNoiseLayout(TerrainMap& map) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, 2);
+    const TerrainType types[3] = {TerrainType::GRASS, TerrainType::WATER, TerrainType::STONE};
+    for (int z = 0; z < map.getSize(); ++z) {
+        for (int x = 0; x < map.getSize(); ++x) {
+            map.set(x, z, types[pick(rng)]);
+        }
+    }
+}
+
+// 草地上开凿的水道迷宫：每个迷宫节点占 4x4 格，水道宽 2 格（深度优先生成）
+void buildMazeLayout(TerrainMap& map) {
+    const int cellStride = 4;
+    const int channelWidth = 2;
+    const int nodes = std::max(1, map.getSize() / cellStride);
+
+    map.fill(TerrainType::GRASS);
+
+    auto carve = [&](int x0, int z0, int w, int d) {
+        for (int z = z0; z < z0 + d && z < map.getSize(); ++z) {
+            for (int x = x0; x < x0 + w && x < map.getSize(); ++x) {
+                map.set(x, z, TerrainType::WATER);
+            }
+        }
+    };
+
+    std::mt19937 rng(6789);
+    std::vector<bool> visited(nodes * nodes, false);
+    std::vector<std::pair<int, int>> stack;
+    stack.push_back({0, 0});
+    visited[0] = true;
+    carve(0, 0, channelWidth, channelWidth);
+
+    const int dirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    while (!stack.empty()) {
+        int nx = stack.back().first;
+        int nz = stack.back().second;
+
+        int candidates[4];
+        int candidateCount = 0;
+        for (int d = 0; d < 4; ++d) {
+            int tx = nx + dirs[d][0];
+            int tz = nz + dirs[d][1];
+            if (tx >= 0 && tx < nodes && tz >= 0 && tz < nodes && !visited[tz * nodes + tx]) {
+                candidates[candidateCount++] = d;
+            }
+        }
+        if (candidateCount == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int d = candidates[rng() % candidateCount];
+        int tx = nx + dirs[d][0];
+        int tz = nz + dirs[d][1];
+        visited[tz * nodes + tx] = true;
+
+        // 打通两个节点之间的水道
+        int x0 = std::min(nx, tx) * cellStride;
+        int z0 = std::min(nz, tz) * cellStride;
+        if (dirs[d][0] != 0) {
+            carve(x0, z0, cellStride + channelWidth, channelWidth);
+        } else {
+            carve(x0, z0, channelWidth, cellStride + channelWidth);
+        }
+        stack.push_back({tx, tz});
+    }
+}
+
+// ===== 计时 =====
+
+BenchResult measure(int iterations, const std::function<void(BenchResult&)>& run) {
+    BenchResult result;
+    double total = 0.0;
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run(result);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        total += ms;
+        best = (i == 0) ? ms : std::min(best, ms);
+    }
+    result.bestMs = best;
+    result.averageMs = total / iterations;
+    return result;
+}
+
+BenchResult benchTerrain(const TerrainMap& map, bool greedy, bool parallel, int iterations) {
+    TerrainMesher mesher(map.getSize());
+    mesher.setGreedyMeshing(greedy);
+    const int chunksPerSide = mesher.getChunksPerSide();
+    const int chunkCount = chunksPerSide * chunksPerSide;
+
+    return measure(iterations, [&](BenchResult& result) {
+        std::vector<TerrainMesher::ChunkMesh> meshes(chunkCount);
+        auto meshOne = [&](int i) {
+            mesher.meshChunk(map, i % chunksPerSide, i / chunksPerSide, meshes[i]);
+        };
+        if (parallel) {
+            ThreadPool::getInstance().parallelFor(chunkCount, meshOne);
+        } else {
+            for (int i = 0; i < chunkCount; ++i) {
+                meshOne(i);
+            }
+        }
+
+        result.vertexCount = 0;
+        result.instanceCount = 0;
+        for (const auto& mesh : meshes) {
+            result.vertexCount += mesh.vertices.size();
+            result.instanceCount += mesh.bricks.size();
+        }
+        result.bytes = result.vertexCount * sizeof(TerrainMesher::TerrainVertex) +
+                       result.instanceCount * sizeof(TerrainMesher::BrickInstance);
+    });
+}
+
+BenchResult benchWater(const TerrainMap& map, int iterations) {
+    return measure(iterations, [&](BenchResult& result) {
+        std::vector<float> vertices;
+        WaterMeshBuilder::buildCellMesh(map, SceneEditor::CELL_SIZE, vertices);
+        result.vertexCount = vertices.size() / 5;
+        result.instanceCount = 0;
+        result.bytes = vertices.size() * sizeof(float);
+    });
+}
+
+BenchResult benchWaterMerged(const TerrainMap& map, int iterations) {
+    // 与默认水面（160m / 100 格）相同的顶点间距
+    const float spacing = 1.6f;
+    return measure(iterations, [&](BenchResult& result) {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        WaterMeshBuilder::buildMergedMesh(map, SceneEditor::CELL_SIZE, spacing, vertices, indices);
+        result.vertexCount = vertices.size() / 5;
+        result.instanceCount = 0;
+        result.bytes = vertices.size() * sizeof(float) + indices.size() * sizeof(unsigned int);
+    });
+}
+
+BenchResult benchWaterTiles(const TerrainMap& map, int iterations) {
+    // 合并网格模式的分块缓冲：每个有水的分块按实际顶点/索引数占用容量为 2 的幂的区间
+    const int tileCells = WaterMeshBuilder::getTileCells(SceneEditor::CELL_SIZE, 1.6f);
+    const int tilesPerSide = (map.getSize() + tileCells - 1) / tileCells;
+    auto rangeCapacity = [](size_t count) {
+        size_t capacity = 1;
+        while (capacity < count) capacity *= 2;
+        return capacity;
+    };
+    return measure(iterations, [&](BenchResult& result) {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        result.vertexCount = 0;
+        result.instanceCount = 0;
+        result.bytes = 0;
+        for (int tz = 0; tz < tilesPerSide; ++tz) {
+            for (int tx = 0; tx < tilesPerSide; ++tx) {
+                WaterMeshBuilder::buildTileMesh(map, tx, tz, tileCells, SceneEditor::CELL_SIZE, vertices, indices);
+                if (indices.empty()) continue;
+                result.vertexCount += vertices.size() / 5;
+                result.bytes += rangeCapacity(vertices.size() / 5) * 5 * sizeof(float)
+                              + rangeCapacity(indices.size()) * sizeof(unsigned int);
+            }
+        }
+    });
+}
+
+BenchResult benchWaterMask(const TerrainMap& map, int iterations) {
+    return measure(iterations, [&](BenchResult& result) {
+        std::vector<unsigned char> mask;
+        WaterMeshBuilder::buildWaterMask(map, mask);
+        result.vertexCount = 0;
+        result.instanceCount = 0;
+        result.bytes = mask.size();
+    });
+}
+
+// ===== 水面高度查询 =====
+
+// 与 WaterSurface 默认一致的 4 个波
+const GerstnerWave BENCH_WAVES[4] = {
+    {glm::vec2(1.0f, 0.0f), 0.15f, 2.0f, 1.0f, 0.3f},
+    {glm::vec2(0.7f, 0.7f), 0.1f, 1.5f, 1.2f, 0.2f},
+    {glm::vec2(0.0f, 1.0f), 0.08f, 1.0f, 0.8f, 0.25f},
+    {glm::vec2(-0.5f, 0.5f), 0.05f, 0.8f, 1.5f, 0.15f},
+};
+
+void buildSamplePoints(int count, std::vector<float>& xs, std::vector<float>& zs) {
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> pick(-80.0f, 80.0f);
+    xs.resize(count);
+    zs.resize(count);
+    for (int i = 0; i < count; ++i) {
+        xs[i] = pick(rng);
+        zs[i] = pick(rng);
+    }
+}
+
+// 逐点逐波 std::sin，即批量接口之前 getWaterHeight 的做法
+BenchResult benchWavesScalar(int count, int iterations) {
+    std::vector<float> xs, zs, heights(count);
+    buildSamplePoints(count, xs, zs);
+    return measure(iterations, [&](BenchResult& result) {
+        for (int i = 0; i < count; ++i) {
+            float height = 0.0f;
+            for (const GerstnerWave& wave : BENCH_WAVES) {
+                float k = 2.0f * 3.14159265f / wave.wavelength;
+                float phase = k * (wave.direction.x * xs[i] + wave.direction.y * zs[i]) - wave.speed * 1.0f;
+                height += wave.amplitude * std::sin(phase);
+            }
+            heights[i] = height;
+        }
+        result.vertexCount = count;
+        result.instanceCount = 0;
+        result.bytes = heights.size() * sizeof(float);
+    });
+}
+
+BenchResult benchWavesBatch(int count, bool withNormals, int iterations) {
+    std::vector<float> xs, zs, heights(count);
+    std::vector<glm::vec3> normals(withNormals ? count : 0);
+    std::vector<glm::vec2> displacements(withNormals ? count : 0);
+    buildSamplePoints(count, xs, zs);
+    return measure(iterations, [&](BenchResult& result) {
+        GerstnerSampler::sample(BENCH_WAVES, 4, 1.0f, xs.data(), zs.data(), count, heights.data(),
+                                withNormals ? normals.data() : nullptr,
+                                withNormals ? displacements.data() : nullptr);
+        result.vertexCount = count;
+        result.instanceCount = 0;
+        result.bytes = heights.size() * sizeof(float) + normals.size() * sizeof(glm::vec3)
+                     + displacements.size() * sizeof(glm::vec2);
+    });
+}
+
+// water.vert 中 calculateGerstnerWave 的 CPU 移植（逐句对应），用于校验 GerstnerSampler
+glm::vec3 shaderGerstnerWave(const glm::vec3& pos, float time, glm::vec3& outNormal) {
+    const float PI = 3.14159265359f;
+    const int waveCount = 4;
+    glm::vec3 result = pos;
+    glm::vec3 tangent(1.0f, 0.0f, 0.0f);
+    glm::vec3 binormal(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < waveCount; ++i) {
+        const GerstnerWave& wave = BENCH_WAVES[i];
+        float k = 2.0f * PI / wave.wavelength;
+        float c = wave.speed;
+        glm::vec2 d = glm::normalize(wave.direction);
+        float f = k * (glm::dot(d, glm::vec2(pos.x, pos.z)) - c * time);
+        float a = wave.amplitude;
+        float q = wave.steepness / (k * a * float(waveCount));
+
+        result.x += q * a * d.x * std::cos(f);
+        result.y += a * std::sin(f);
+        result.z += q * a * d.y * std::cos(f);
+
+        float wa = k * a;
+        float s = std::sin(f);
+        float c_f = std::cos(f);
+
+        tangent.x -= q * d.x * d.x * wa * s;
+        tangent.y -= d.x * wa * c_f;
+        tangent.z -= q * d.x * d.y * wa * s;
+
+        binormal.x -= q * d.x * d.y * wa * s;
+        binormal.y -= d.y * wa * c_f;
+        binormal.z -= q * d.y * d.y * wa * s;
+    }
+
+    outNormal = glm::normalize(glm::cross(binormal, tangent));
+    return result;
+}
+
+/**
+ * @brief 把网格点按着色器位移后，在位移后的 XZ 处查询 GerstnerSampler，比较高度/法线/速度
+ * @return 默认迭代次数下高度误差是否在容差内
+ */
+bool verifyGerstnerInversion() {
+    const int count = 65536;
+    // 时间与差分步长都取 2 的幂分数，t ± dt 可精确表示
+    const float time = 37.25f;
+    const float dt = 1.0f / 256.0f;
+    std::vector<float> gridXs, gridZs;
+    buildSamplePoints(count, gridXs, gridZs);
+
+    std::vector<float> xs(count), zs(count), expectedHeights(count);
+    std::vector<glm::vec3> expectedNormals(count), expectedVelocities(count);
+    for (int i = 0; i < count; ++i) {
+        glm::vec3 p(gridXs[i], 0.0f, gridZs[i]);
+        glm::vec3 normal, unused;
+        glm::vec3 displaced = shaderGerstnerWave(p, time, normal);
+        glm::vec3 ahead = shaderGerstnerWave(p, time + dt, unused);
+        glm::vec3 behind = shaderGerstnerWave(p, time - dt, unused);
+        xs[i] = displaced.x;
+        zs[i] = displaced.z;
+        expectedHeights[i] = displaced.y;
+        expectedNormals[i] = normal;
+        expectedVelocities[i] = (ahead - behind) / (2.0f * dt);
+    }
+
+    std::cout << "\nGerstner inversion vs water.vert port (" << count << " points, "
+              << GerstnerSampler::getInstructionSet() << ")" << std::endl;
+    std::vector<float> heights(count);
+    std::vector<glm::vec3> normals(count), velocities(count);
+    float defaultError = 0.0f;
+    for (int iterations = 0; iterations <= 6; ++iterations) {
+        GerstnerSampler::sample(BENCH_WAVES, 4, time, xs.data(), zs.data(), count, heights.data(),
+                                normals.data(), nullptr, velocities.data(), iterations);
+        float heightError = 0.0f, normalError = 0.0f, velocityError = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            heightError = std::max(heightError, std::abs(heights[i] - expectedHeights[i]));
+            normalError = std::max(normalError, glm::length(normals[i] - expectedNormals[i]));
+            velocityError = std::max(velocityError, glm::length(velocities[i] - expectedVelocities[i]));
+        }
+        std::cout << "  iterations " << iterations << std::scientific << std::setprecision(2)
+                  << "  height " << heightError << " m"
+                  << "  normal " << normalError
+                  << "  velocity " << velocityError << " m/s"
+                  << (iterations == GerstnerSampler::DEFAULT_ITERATIONS ? "  (default)" : "")
+                  << std::defaultfloat << std::endl;
+        if (iterations == GerstnerSampler::DEFAULT_ITERATIONS) {
+            defaultError = heightError;
+        }
+    }
+    return defaultError < 1e-3f;
+}
+
+// 高度场缓存插值与直接求值的最大允许高度差（米）
+const float HEIGHTFIELD_TOLERANCE = 2e-3f;
+
+/**
+ * @brief 在船只大小的窗口上建高度场，窗口内随机点的插值结果与 GerstnerSampler 直接求值比较
+ * @return 所有点都命中缓存且高度差在 HEIGHTFIELD_TOLERANCE 内
+ */
+bool verifyHeightfield() {
+    const int count = 65536;
+    const float time = 37.25f;
+    const glm::vec2 areaMin(-3.0f, -2.0f);
+    const glm::vec2 areaMax(3.0f, 4.0f);
+
+    float minWavelength = BENCH_WAVES[0].wavelength;
+    for (const GerstnerWave& wave : BENCH_WAVES) {
+        minWavelength = std::min(minWavelength, wave.wavelength);
+    }
+
+    WaveHeightfield heightfield;
+    heightfield.build(areaMin, areaMax, WaveHeightfield::spacingForWavelength(minWavelength), time,
+                      [&](const float* xs, const float* zs, int n, float* outHeights) {
+                          GerstnerSampler::sample(BENCH_WAVES, 4, time, xs, zs, n, outHeights);
+                      });
+
+    std::mt19937 rng(8765);
+    std::uniform_real_distribution<float> pickX(areaMin.x, areaMax.x);
+    std::uniform_real_distribution<float> pickZ(areaMin.y, areaMax.y);
+    std::vector<float> xs(count), zs(count), expected(count);
+    for (int i = 0; i < count; ++i) {
+        xs[i] = pickX(rng);
+        zs[i] = pickZ(rng);
+    }
+    GerstnerSampler::sample(BENCH_WAVES, 4, time, xs.data(), zs.data(), count, expected.data());
+
+    int misses = 0;
+    float heightError = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        float height = 0.0f;
+        if (!heightfield.sample(xs[i], zs[i], height)) {
+            ++misses;
+            continue;
+        }
+        heightError = std::max(heightError, std::abs(height - expected[i]));
+    }
+
+    std::cout << "\nHeightfield cache vs direct sampling (" << count << " points, "
+              << heightfield.getSampleCount() << " samples at " << heightfield.getSpacing() << " m)" << std::endl;
+    std::cout << "  misses " << misses << std::scientific << std::setprecision(2)
+              << "  height " << heightError << " m" << std::defaultfloat << std::endl;
+    return misses == 0 && heightError <= HEIGHTFIELD_TOLERANCE;
+}
+
+// ===== FFT 海浪 =====
+
+// 一个模拟步的频谱演化 + 三个场的二维逆 FFT，vertices 列为采样点数
+BenchResult benchOceanUpdate(int resolution, int iterations) {
+    OceanSpectrum::Settings settings;
+    settings.resolution = resolution;
+    OceanSpectrum ocean(settings);
+    float time = 1.0f;
+    return measure(iterations, [&](BenchResult& result) {
+        time += 1.0f / 60.0f;
+        ocean.update(time);
+        result.vertexCount = resolution * resolution;
+        result.instanceCount = 0;
+        result.bytes = (ocean.getDisplacements().size() + ocean.getNormals().size()) * sizeof(glm::vec4);
+    });
+}
+
+BenchResult benchOceanSample(int count, int iterations) {
+    OceanSpectrum ocean;
+    ocean.update(1.0f);
+    std::vector<float> xs, zs, heights(count);
+    buildSamplePoints(count, xs, zs);
+    return measure(iterations, [&](BenchResult& result) {
+        ocean.sample(xs.data(), zs.data(), count, heights.data());
+        result.vertexCount = count;
+        result.instanceCount = 0;
+        result.bytes = heights.size() * sizeof(float);
+    });
+}
+
+// ===== 船只尾迹 =====
+
+// 每次测量前先让船跑一段，高度场里有真实的波；每次迭代积分一步，vertices 列为格子数
+BenchResult benchWakeStep(int resolution, bool multithreaded, int iterations) {
+    WakeSimulation::Settings settings;
+    settings.resolution = resolution;
+    settings.multithreaded = multithreaded;
+    WakeSimulation wake(settings);
+
+    glm::vec2 position(0.0f);
+    const glm::vec2 forward(0.6f, 0.8f);
+    const float dt = settings.timeStep;
+    auto advanceBoat = [&]() {
+        position += forward * 5.0f * dt;
+        wake.setCenter(position);
+        wake.applyHull(position, forward, 1.0f, 0.4f, 5.0f, dt);
+    };
+    for (int i = 0; i < 60; ++i) {
+        advanceBoat();
+        wake.step();
+    }
+
+    return measure(iterations, [&](BenchResult& result) {
+        advanceBoat();
+        wake.step();
+        result.vertexCount = resolution * resolution;
+        result.instanceCount = 0;
+        result.bytes = wake.getHeights().size() * sizeof(float);
+    });
+}
+
+void printHeader() {
+    std::cout << std::left
+              << std::setw(9) << "layout"
+              << std::setw(7) << "size"
+              << std::setw(22) << "case"
+              << std::right
+              << std::setw(11) << "best ms"
+              << std::setw(11) << "avg ms"
+              << std::setw(12) << "vertices"
+              << std::setw(11) << "instances"
+              << std::setw(13) << "bytes"
+              << std::endl;
+}
+
+void printRow(const std::string& layout, int size, const std::string& name, const BenchResult& r) {
+    std::cout << std::left
+              << std::setw(9) << layout
+              << std::setw(7) << size
+              << std::setw(22) << name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(11) << r.bestMs
+              << std::setw(11) << r.averageMs
+              << std::setw(12) << r.vertexCount
+              << std::setw(11) << r.instanceCount
+              << std::setw(13) << r.bytes
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5;
+    std::vector<int> sizes;
+    if (argc > 1) {
+        iterations = std::max(1, std::atoi(argv[1]));
+    }
+    for (int i = 2; i < argc; ++i) {
+        int size = std::atoi(argv[i]);
+        if (size > 0) sizes.push_back(size);
+    }
+    if (sizes.empty()) {
+        sizes = {128, 320, 640, 1024};
+    }
+
+    const std::pair<const char*, void (*)(TerrainMap&)> layouts[] = {
+        {"default", buildDefaultLayout},
+        {"noise", buildNoiseLayout},
+        {"maze", buildMazeLayout},
+    };
+
+    std::cout << "TerrainMeshBench: " << iterations << " iterations, "
+              << (ThreadPool::getInstance().getThreadCount() + 1) << " threads" << std::endl;
+    printHeader();
+
+    for (const auto& layout : layouts) {
+        for (int size : sizes) {
+            TerrainMap map(size);
+            layout.second(map);
+
+            printRow(layout.first, size, "terrain greedy",
+                     benchTerrain(map, true, false, iterations));
+            printRow(layout.first, size, "terrain greedy mt",
+                     benchTerrain(map, true, true, iterations));
+            printRow(layout.first, size, "terrain per-cell",
+                     benchTerrain(map, false, false, iterations));
+            printRow(layout.first, size, "water cells",
+                     benchWater(map, iterations));
+            printRow(layout.first, size, "water merged",
+                     benchWaterMerged(map, iterations));
+            printRow(layout.first, size, "water tiles",
+                     benchWaterTiles(map, iterations));
+            printRow(layout.first, size, "water mask",
+                     benchWaterMask(map, iterations));
+        }
+    }
+
+    // 水面高度查询：vertices 列为采样点数
+    const std::string batchName = std::string("waves ") + GerstnerSampler::getInstructionSet();
+    for (int count : {1024, 16384, 262144}) {
+        printRow("waves", count, "waves scalar sin", benchWavesScalar(count, iterations));
+        printRow("waves", count, batchName, benchWavesBatch(count, false, iterations));
+        printRow("waves", count, batchName + " +normals", benchWavesBatch(count, true, iterations));
+    }
+
+    for (int resolution : {64, 128, 256}) {
+        printRow("ocean", resolution, "ocean fft update", benchOceanUpdate(resolution, iterations));
+    }
+    for (int count : {1024, 16384}) {
+        printRow("ocean", count, "ocean sample", benchOceanSample(count, iterations));
+    }
+
+    for (int resolution : {128, 256, 512}) {
+        printRow("wake", resolution, "wake step", benchWakeStep(resolution, false, iterations));
+        printRow("wake", resolution, "wake step mt", benchWakeStep(resolution, true, iterations));
+    }
+
+    if (!verifyGerstnerInversion()) {
+        std::cout << "Gerstner inversion error exceeds 1e-3 m" << std::endl;
+        return 1;
+    }
+
+    if (!verifyHeightfield()) {
+        std::cout << "Heightfield cache misses or differs from direct sampling by more than "
+                  << HEIGHTFIELD_TOLERANCE << " m" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace WaterTown {
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : m_stopping(false) {
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        // 调用线程也参与计算，所以工作线程少开一个
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    m_workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance;
+    return instance;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            job = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        job();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    if (m_workers.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // 所有参与线程从共享计数器中领取任务索引，任务粒度不均时也能自动均衡
+    struct SharedState {
+        std::atomic<int> nextIndex{0};
+        std::atomic<int> remaining{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+    };
+    auto state = std::make_shared<SharedState>();
+    state->remaining = count;
+
+    auto drain = [state, count, &task]() {
+        int index;
+        while ((index = state->nextIndex.fetch_add(1)) < count) {
+            task(index);
+            if (state->remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(state->doneMutex);
+                state->doneCondition.notify_all();
+            }
+        }
+    };
+
+    unsigned int helpers = std::min(static_cast<unsigned int>(count - 1), getThreadCount());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (unsigned int i = 0; i < helpers; ++i) {
+            m_tasks.push(drain);
+        }
+    }
+    m_condition.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->doneCondition.wait(lock, [&state]() { return state->remaining.load() == 0; });
+}
+
+} // namespace WaterTown
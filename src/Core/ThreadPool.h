@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 固定大小的工作线程池，用于地形网格、水面高度场等可并行的 CPU 计算
+ *
+ * 任务中不能调用 OpenGL（上下文只属于主线程），结果应写入各自的缓冲，
+ * 由主线程在 parallelFor 返回后统一上传。
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数，0 表示使用硬件并发数
+     */
+    explicit ThreadPool(unsigned int threadCount = 0);
+    
+    /**
+     * @brief 析构函数，等待线程退出
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief 并行执行 task(0..count-1)，阻塞直到全部完成
+     * 调用线程也参与执行，因此在单核机器上等价于串行循环
+     * @param count 任务数
+     * @param task 任务函数，参数为任务索引
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+    
+    /**
+     * @brief 获取工作线程数（不含调用线程）
+     */
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+    
+    /**
+     * @brief 获取全局共享线程池
+     */
+    static ThreadPool& getInstance();
+
+private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping;
+    
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop();
+};
+
+} // namespace WaterTown
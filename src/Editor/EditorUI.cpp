@@ -1,4 +1,5 @@
 #include "EditorUI.h"
+#include "../Render/RenderState.h"
 #include <imgui.h>
 #include <iostream>
 
@@ -32,6 +33,12 @@ void EditorUI::render() {
     
     m_fps = ImGui::GetIO().Framerate;
     
+    // 位平面维护了各类型计数，直接读取
+    const TerrainMap& terrainMap = m_editor->getTerrainMap();
+    m_terrainCount[0] = terrainMap.count(TerrainType::GRASS);
+    m_terrainCount[1] = terrainMap.count(TerrainType::WATER);
+    m_terrainCount[2] = terrainMap.count(TerrainType::STONE);
+    
     // 主控制面板
     renderModePanel();
     renderToolPanel();
@@ -289,6 +296,31 @@ void EditorUI::renderSettingsPanel() {
     ImGui::Checkbox("Show Water", &m_showWater);
     ImGui::Checkbox("Show Objects", &m_showObjects);
     
+    bool mergedWater = (m_editor->getWaterMeshMode() == WaterMeshMode::MERGED_MESH);
+    if (ImGui::Checkbox("Merged Water Mesh", &mergedWater)) {
+        m_editor->setWaterMeshMode(mergedWater ? WaterMeshMode::MERGED_MESH : WaterMeshMode::MASK);
+    }
+    
+    bool heightfield = m_editor->isWaterHeightfieldEnabled();
+    if (ImGui::Checkbox("Cached Wave Heightfield", &heightfield)) {
+        m_editor->setWaterHeightfieldEnabled(heightfield);
+    }
+    
+    bool fftOcean = m_editor->isWaterFftOceanEnabled();
+    if (ImGui::Checkbox("FFT Ocean Waves", &fftOcean)) {
+        m_editor->setWaterFftOceanEnabled(fftOcean);
+    }
+    
+    bool wake = m_editor->isWaterWakeEnabled();
+    if (ImGui::Checkbox("Boat Wake", &wake)) {
+        m_editor->setWaterWakeEnabled(wake);
+    }
+    
+    bool clipmap = m_editor->isWaterClipmapEnabled();
+    if (ImGui::Checkbox("Water LOD Clipmap", &clipmap)) {
+        m_editor->setWaterClipmapEnabled(clipmap);
+    }
+    
     ImGui::Separator();
     
     ImGui::SliderFloat("Grid Size", &m_gridSize, 0.5f, 2.0f, "%.1f");
@@ -298,7 +330,7 @@ void EditorUI::renderSettingsPanel() {
 
 void EditorUI::renderStatsPanel() {
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 260, 10), ImGuiCond_FirstUseEver);
-    ImGui::SetNextWindowSize(ImVec2(250, 150), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(250, 210), ImGuiCond_FirstUseEver);
     
     ImGui::Begin("Statistics");
     
@@ -311,12 +343,21 @@ void EditorUI::renderStatsPanel() {
     ImGui::Text("  Grass: %d", m_terrainCount[0]);
     ImGui::Text("  Water: %d", m_terrainCount[1]);
     ImGui::Text("  Stone: %d", m_terrainCount[2]);
+    ImGui::Text("Water Regions: %d (%d wave sets)",
+                m_editor->getWaterRegionCount(), m_editor->getWaterWaveSetCount());
+    
+    // 上一帧经过 RenderState 的绑定/开关调用
+    const RenderState::Stats& glStats = RenderState::getLastFrameStats();
+    ImGui::Separator();
+    ImGui::Text("GL State Calls:");
+    ImGui::Text("  Issued: %d", glStats.issued);
+    ImGui::Text("  Skipped: %d", glStats.skipped);
     
     ImGui::End();
 }
 
 void EditorUI::renderScenePanel() {
-    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 260, 170), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 260, 230), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(250, 150), ImGuiCond_FirstUseEver);
     
     ImGui::Begin("Scene Management");
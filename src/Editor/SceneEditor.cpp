@@ -7,15 +7,38 @@
 #include "Render/Camera.h"
 #include "Render/ObjectRenderer.h"
 #include "Water/WaterSurface.h"
+#include "Water/WaterMeshBuilder.h"
 #include "Physics/Boat.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 #include <set>
 
 namespace WaterTown {
 
+namespace {
+
+// 按水域面积缩放默认波浪：面积越小振幅越小、波长越短、波数越少（area 为平方米）
+std::vector<GerstnerWave> buildRegionWaves(const std::vector<GerstnerWave>& defaultWaves, float area) {
+    std::vector<GerstnerWave> waves = defaultWaves;
+
+    // 以边长约 30m 的水面为满尺度，小池塘压到 15%
+    float scale = glm::clamp(std::sqrt(area) / 30.0f, 0.15f, 1.0f);
+    size_t count = (area < 40.0f) ? 2 : (area < 400.0f ? 3 : 4);
+    if (waves.size() > count) waves.resize(count);
+
+    for (GerstnerWave& wave : waves) {
+        wave.amplitude *= scale;
+        wave.wavelength *= 0.5f + 0.5f * scale;
+        wave.speed *= std::sqrt(0.5f + 0.5f * scale);
+    }
+    return waves;
+}
+
+} // namespace
+
 SceneEditor::SceneEditor()
     : m_currentMode(EditorMode::TERRAIN),
       m_orthoCamera(nullptr),
@@ -24,6 +47,14 @@ SceneEditor::SceneEditor()
       m_waterSurface(nullptr),
       m_boat(nullptr),
       m_objectRenderer(nullptr),
+      m_terrainMap(GRID_SIZE),
+      m_terrainGeneration(0),
+      m_waterMeshMode(WaterMeshMode::MASK),
+      m_waterTileCells(1),
+      m_waterTilesPerSide(0),
+      m_waterRegionsDirty(true),
+      m_waterRegionCount(0),
+      m_waterWaveSetCount(0),
       m_riverStartColumn(0),
       m_riverEndColumn(0),
       m_currentTerrainType(TerrainType::GRASS),
@@ -32,12 +63,8 @@ SceneEditor::SceneEditor()
       m_boatPlaced(false),
       m_boatPlacedPosition(0.0f) {
       
-    // 默认全空
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        for (int z = 0; z < GRID_SIZE; ++z) {
-            m_terrainGrid[x][z] = TerrainType::EMPTY;
-        }
-    }
+    // 默认全空（TerrainMap 构造时已填充 EMPTY）
+    markAllTerrainDirty();
 }
 
 SceneEditor::~SceneEditor() {
@@ -101,7 +128,7 @@ void SceneEditor::init(float aspectRatio) {
         if (gx < 0 || gx >= GRID_SIZE || gz < 0 || gz >= GRID_SIZE) return false;
         
         // 只有 WATER 视为安全
-        return m_terrainGrid[gx][gz] == TerrainType::WATER;
+        return m_terrainMap.get(gx, gz) == TerrainType::WATER;
     });
 
     // 创建物体渲染器
@@ -127,48 +154,7 @@ void SceneEditor::initializeTerrainLayout() {
     // 我们保留边缘为 EMPTY，中间为场景？
     // 为了匹配 Sec 的效果，我们将整个 GRID 填满。
     
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        for (int z = 0; z < GRID_SIZE; ++z) {
-            m_terrainGrid[x][z] = TerrainType::WATER; // 先铺满水，类似威尼斯/江南
-        }
-    }
-    
-    // 定义河道宽度和岸线厚度
-    const int riverWidth = static_cast<int>(GRID_SIZE * 0.25f);   // 中央河道宽 25%
-    const int bankWidth = 3;                                    // 石质河岸厚度
-    const int center = GRID_SIZE / 2;
-    m_riverStartColumn = center - riverWidth / 2;
-    m_riverEndColumn = m_riverStartColumn + riverWidth;
-    
-    // 生成陆地
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        TerrainType columnType;
-        if (x >= m_riverStartColumn && x < m_riverEndColumn) {
-            columnType = TerrainType::WATER; // 河道
-        }
-        else if ((x >= m_riverStartColumn - bankWidth && x < m_riverStartColumn) ||
-                 (x >= m_riverEndColumn && x < m_riverEndColumn + bankWidth)) {
-            columnType = TerrainType::STONE; // 石砌河岸
-        }
-        else {
-            columnType = TerrainType::GRASS; // 城镇陆地
-        }
-        
-        for (int z = 0; z < GRID_SIZE; ++z) {
-            m_terrainGrid[x][z] = columnType;
-        }
-    }
-    
-    // 在石岸上加几段码头/广场
-    int plazaDepth = GRID_SIZE / 5;
-    for (int z = GRID_SIZE / 3; z < GRID_SIZE / 3 + plazaDepth; ++z) {
-        for (int x = m_riverStartColumn - bankWidth - 3; x < m_riverStartColumn - bankWidth; ++x) {
-            if (x >= 0) m_terrainGrid[x][z] = TerrainType::STONE;
-        }
-        for (int x = m_riverEndColumn + bankWidth; x < m_riverEndColumn + bankWidth + 3; ++x) {
-            if (x < GRID_SIZE) m_terrainGrid[x][z] = TerrainType::STONE;
-        }
-    }
+    m_terrainMap.generateDefaultLayout(m_riverStartColumn, m_riverEndColumn);
     
     // 标记船只放置状态（默认场景没有船，或者我们可以放一艘？）
     // Sec 在 init 里 placeBoat。我们可以放一艘在河中心。
@@ -195,9 +181,17 @@ void SceneEditor::initializeTerrainLayout() {
     // 清空历史记录
     m_terrainHistory.clear();
     m_objectHistory.clear();
+    
+    markAllTerrainDirty();
 }
 
 void SceneEditor::update(float deltaTime) {
+    // 本帧累积的地形编辑统一同步到水面
+    flushWaterEdits();
+    if (m_waterRegionsDirty) {
+        updateWaterRegions();
+    }
+
     // 更新过渡状态
     if (m_isTransitioning) {
         m_transitionTime += deltaTime;
@@ -221,6 +215,20 @@ void SceneEditor::update(float deltaTime) {
 
     float currentTime = static_cast<float>(glfwGetTime());
 
+    // 推进波浪（FFT 模式下在此做逆 FFT 并上传纹理，本帧的浮力与渲染共用这一结果）
+    if (m_waterSurface) {
+        m_waterSurface->update(currentTime);
+    }
+
+    // 高度场缓存：本帧的浮力查询都落在船只周围，按同一时刻只计算一次波浪和。
+    // 覆盖半径取船体采样点的范围，再留出本帧船只移动的余量
+    if (m_waterSurface && m_waterSurface->isHeightfieldEnabled() && m_boat) {
+        std::vector<glm::vec2> focusPoints;
+        focusPoints.push_back(glm::vec2(m_boat->getPosition().x, m_boat->getPosition().z));
+        float margin = 0.5f * std::max(m_boat->getLength(), m_boat->getWidth()) + 0.5f;
+        m_waterSurface->updateHeightfield(currentTime, focusPoints, margin);
+    }
+
     // 只在游戏模式下更新船只物理（运动、碰撞）
     // 在其他模式下只更新浮力效果（视觉上的水波浮动）
     if (m_currentMode == EditorMode::GAME) {
@@ -234,6 +242,16 @@ void SceneEditor::update(float deltaTime) {
         }
     }
 
+    // 船只尾迹：跟随船只，非游戏模式下船速为 0，已有的波自然衰减
+    if (m_boat && m_waterSurface && m_waterSurface->isWakeEnabled()) {
+        float rotRad = glm::radians(m_boat->getRotation());
+        glm::vec2 forward(std::sin(rotRad), std::cos(rotRad));
+        float speed = (m_currentMode == EditorMode::GAME) ? m_boat->getSpeed() : 0.0f;
+        m_waterSurface->updateWake(deltaTime,
+                                   glm::vec2(m_boat->getPosition().x, m_boat->getPosition().z),
+                                   forward, speed, m_boat->getLength(), m_boat->getWidth());
+    }
+
     // 游戏模式下更新追随相机
     if (m_currentMode == EditorMode::GAME && m_followCamera && m_boat) {
         m_followCamera->setTarget(m_boat->getPosition(), m_boat->getRotation());
@@ -250,55 +268,218 @@ void SceneEditor::setWaterSurface(WaterSurface* water) {
 }
 
 void SceneEditor::updateWaterMesh() {
+    // 整体重建会覆盖所有待同步的格子
+    m_pendingWaterCells.clear();
+    m_waterRegionsDirty = true;
     if (!m_waterSurface) return;
 
-    // 收集所有 WATER 类型的格子，生成网格数据传给 WaterSurface
-    std::vector<float> vertices; 
-    
-    float halfSize = GRID_SIZE / 2.0f;
-    float uvScale = 0.1f; // UV 缩放因子
-    
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        for (int z = 0; z < GRID_SIZE; ++z) {
-            if (m_terrainGrid[x][z] == TerrainType::WATER) {
-                float x0 = (x - halfSize) * CELL_SIZE;
-                float z0 = (z - halfSize) * CELL_SIZE;
-                float x1 = x0 + CELL_SIZE;
-                float z1 = z0 + CELL_SIZE;
-                float y = 0.0f; // Base level
-                
-                // Triangle 1
-                // Vertex 0 (x0, z0)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Vertex 1 (x0, z1)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z1 * uvScale);
-                
-                // Vertex 2 (x1, z0)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Triangle 2
-                // Vertex 3 (x1, z0)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Vertex 4 (x0, z1)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z1 * uvScale);
-                
-                // Vertex 5 (x1, z1)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z1 * uvScale);
+    // 遮罩始终保持最新，切换模式时无需重建
+    std::vector<unsigned char> mask;
+    WaterMeshBuilder::buildWaterMask(m_terrainMap, mask);
+    float origin = -GRID_SIZE / 2.0f * CELL_SIZE;
+    m_waterSurface->setWaterMask(mask, GRID_SIZE, CELL_SIZE, origin, origin);
+
+    if (m_waterMeshMode == WaterMeshMode::MERGED_MESH) {
+        // 按分块生成，之后的编辑只改写受影响分块的区间
+        m_waterTileCells = WaterMeshBuilder::getTileCells(CELL_SIZE, m_waterSurface->getMaxVertexSpacing());
+        m_waterTilesPerSide = (GRID_SIZE + m_waterTileCells - 1) / m_waterTileCells;
+        int tileCount = m_waterTilesPerSide * m_waterTilesPerSide;
+        m_waterTilePatches.assign(tileCount, -1);
+
+        // 按每块一个矩形粗略预留，不够时缓冲自行翻倍
+        m_waterSurface->getPatchPool().reset(tileCount, tileCount * 6);
+        for (int tile = 0; tile < tileCount; ++tile) {
+            updateWaterTile(tile);
+        }
+        m_waterSurface->usePatchPool();
+    } else {
+        // 水面保持规则网格，非水格子在着色器中丢弃
+        m_waterSurface->resetMesh();
+    }
+}
+
+void SceneEditor::setWaterMeshMode(WaterMeshMode mode) {
+    if (m_waterMeshMode == mode) return;
+    m_waterMeshMode = mode;
+    updateWaterMesh();
+}
+
+void SceneEditor::setWaterHeightfieldEnabled(bool enabled) {
+    if (m_waterSurface) {
+        m_waterSurface->setHeightfieldEnabled(enabled);
+    }
+}
+
+bool SceneEditor::isWaterHeightfieldEnabled() const {
+    return m_waterSurface && m_waterSurface->isHeightfieldEnabled();
+}
+
+void SceneEditor::setWaterFftOceanEnabled(bool enabled) {
+    if (!m_waterSurface) return;
+    m_waterSurface->setWaveModel(enabled ? WaterSurface::WaveModel::FFT_OCEAN : WaterSurface::WaveModel::GERSTNER);
+    m_waterSurface->update(static_cast<float>(glfwGetTime()));
+}
+
+bool SceneEditor::isWaterFftOceanEnabled() const {
+    return m_waterSurface && m_waterSurface->getWaveModel() == WaterSurface::WaveModel::FFT_OCEAN;
+}
+
+void SceneEditor::setWaterWakeEnabled(bool enabled) {
+    if (m_waterSurface) {
+        m_waterSurface->setWakeEnabled(enabled);
+    }
+}
+
+bool SceneEditor::isWaterWakeEnabled() const {
+    return m_waterSurface && m_waterSurface->isWakeEnabled();
+}
+
+void SceneEditor::setWaterClipmapEnabled(bool enabled) {
+    if (m_waterSurface) {
+        m_waterSurface->setClipmapEnabled(enabled);
+    }
+}
+
+bool SceneEditor::isWaterClipmapEnabled() const {
+    return m_waterSurface && m_waterSurface->isClipmapEnabled();
+}
+
+void SceneEditor::queueWaterCell(int gridX, int gridZ) {
+    if (!m_waterSurface) return;
+    m_pendingWaterCells.push_back(gridZ * GRID_SIZE + gridX);
+}
+
+void SceneEditor::flushWaterEdits() {
+    if (m_pendingWaterCells.empty()) return;
+    if (!m_waterSurface) {
+        m_pendingWaterCells.clear();
+        return;
+    }
+
+    // 遮罩：本帧所有变化格子的包围盒一次上传
+    int minX = GRID_SIZE, minZ = GRID_SIZE, maxX = -1, maxZ = -1;
+    for (int cell : m_pendingWaterCells) {
+        int x = cell % GRID_SIZE;
+        int z = cell / GRID_SIZE;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minZ = std::min(minZ, z);
+        maxZ = std::max(maxZ, z);
+    }
+    int width = maxX - minX + 1;
+    int height = maxZ - minZ + 1;
+    std::vector<unsigned char> region(width * height);
+    for (int z = 0; z < height; ++z) {
+        for (int x = 0; x < width; ++x) {
+            bool water = m_terrainMap.get(minX + x, minZ + z) == TerrainType::WATER;
+            region[z * width + x] = water ? 255 : 0;
+        }
+    }
+    m_waterSurface->setWaterMaskRegion(minX, minZ, width, height, region.data());
+
+    // 合并网格：每个受影响的分块只重建一次；分块边界按相邻分块的矩形角点拆分，四邻也要重建
+    if (m_waterMeshMode == WaterMeshMode::MERGED_MESH && !m_waterTilePatches.empty()) {
+        const int neighbours[5][2] = {{0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        std::vector<int> tiles;
+        tiles.reserve(m_pendingWaterCells.size() * 5);
+        for (int cell : m_pendingWaterCells) {
+            int tileX = (cell % GRID_SIZE) / m_waterTileCells;
+            int tileZ = (cell / GRID_SIZE) / m_waterTileCells;
+            for (const auto& offset : neighbours) {
+                int nx = tileX + offset[0];
+                int nz = tileZ + offset[1];
+                if (nx < 0 || nz < 0 || nx >= m_waterTilesPerSide || nz >= m_waterTilesPerSide) continue;
+                tiles.push_back(nz * m_waterTilesPerSide + nx);
             }
         }
+        std::sort(tiles.begin(), tiles.end());
+        tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+        for (int tile : tiles) {
+            updateWaterTile(tile);
+        }
     }
-    
-    m_waterSurface->updateMesh(vertices);
+
+    m_pendingWaterCells.clear();
+    m_waterRegionsDirty = true;
 }
 
+void SceneEditor::updateWaterRegions() {
+    m_waterRegionsDirty = false;
+    if (!m_waterSurface) return;
+
+    std::vector<int> labels;
+    std::vector<WaterRegionInfo> infos;
+    int regionCount = WaterMeshBuilder::labelWaterRegions(m_terrainMap, labels, infos);
+
+    // 按面积从大到小分配波浪组；超出上限的小水域共用最后一组（按最小水域的尺度）
+    std::vector<int> order(regionCount);
+    for (int i = 0; i < regionCount; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return infos[a].cellCount > infos[b].cellCount;
+    });
+
+    const int maxRegions = WaterSurface::MAX_WAVE_SETS - 1;
+    const float cellArea = CELL_SIZE * CELL_SIZE;
+    const float origin = -GRID_SIZE / 2.0f * CELL_SIZE;
+    std::vector<unsigned char> setOfLabel(regionCount + 1, 0);
+    std::vector<WaterSurface::WaterRegion> regions;
+    for (int rank = 0; rank < regionCount; ++rank) {
+        const WaterRegionInfo& info = infos[order[rank]];
+        glm::vec2 boundsMin(origin + info.minX * CELL_SIZE, origin + info.minZ * CELL_SIZE);
+        glm::vec2 boundsMax(origin + (info.maxX + 1) * CELL_SIZE, origin + (info.maxZ + 1) * CELL_SIZE);
+
+        if (rank < maxRegions - 1 || regionCount <= maxRegions) {
+            WaterSurface::WaterRegion region;
+            region.boundsMin = boundsMin;
+            region.boundsMax = boundsMax;
+            region.waves = buildRegionWaves(m_waterSurface->getWaves(), info.cellCount * cellArea);
+            regions.push_back(region);
+        } else if (static_cast<int>(regions.size()) < maxRegions) {
+            WaterSurface::WaterRegion shared;
+            shared.boundsMin = boundsMin;
+            shared.boundsMax = boundsMax;
+            shared.waves = buildRegionWaves(m_waterSurface->getWaves(), infos[order.back()].cellCount * cellArea);
+            regions.push_back(shared);
+        } else {
+            regions.back().boundsMin = glm::min(regions.back().boundsMin, boundsMin);
+            regions.back().boundsMax = glm::max(regions.back().boundsMax, boundsMax);
+        }
+        setOfLabel[order[rank] + 1] = static_cast<unsigned char>(regions.size());
+    }
+
+    std::vector<unsigned char> regionMap(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+        regionMap[i] = setOfLabel[labels[i]];
+    }
+    m_waterSurface->setWaterRegions(regionMap, GRID_SIZE, CELL_SIZE, origin, origin, regions);
+
+    m_waterRegionCount = regionCount;
+    m_waterWaveSetCount = static_cast<int>(regions.size());
+}
+
+void SceneEditor::updateWaterTile(int tile) {
+    WaterPatchPool& pool = m_waterSurface->getPatchPool();
+    int tileX = tile % m_waterTilesPerSide;
+    int tileZ = tile / m_waterTilesPerSide;
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    WaterMeshBuilder::buildTileMesh(m_terrainMap, tileX, tileZ, m_waterTileCells, CELL_SIZE, vertices, indices);
+
+    int& patch = m_waterTilePatches[tile];
+    if (indices.empty()) {
+        if (patch >= 0) {
+            pool.release(patch);
+            patch = -1;
+        }
+        return;
+    }
+
+    if (patch < 0) {
+        patch = pool.allocate();
+    }
+    pool.write(patch, vertices, indices);
+}
 
 void SceneEditor::switchMode(EditorMode mode) {
     if (m_currentMode == mode) return;
@@ -390,7 +571,7 @@ void SceneEditor::removeObjectsOnWaterExceptBoat() {
         int gx = static_cast<int>(std::floor(p.x / cell + GRID_SIZE / 2.0f));
         int gz = static_cast<int>(std::floor(p.z / cell + GRID_SIZE / 2.0f));
         if (gx < 0 || gx >= GRID_SIZE || gz < 0 || gz >= GRID_SIZE) return false;
-        return m_terrainGrid[gx][gz] == TerrainType::WATER;
+        return m_terrainMap.get(gx, gz) == TerrainType::WATER;
     };
 
     auto prune = [&](std::vector<std::pair<ObjectType, glm::vec3>>& list) {
@@ -419,17 +600,19 @@ void SceneEditor::removeObjectsOnWaterExceptBoat() {
 void SceneEditor::placeTerrain(int gridX, int gridZ, TerrainType type) {
     if (gridX < 0 || gridX >= GRID_SIZE || gridZ < 0 || gridZ >= GRID_SIZE) return;
     
-    TerrainType oldType = m_terrainGrid[gridX][gridZ];
+    TerrainType oldType = m_terrainMap.get(gridX, gridZ);
     if (oldType == type) return; // 无变化
     
     // 记录撤销
     m_terrainHistory.push_back({gridX, gridZ, oldType, type});
     
-    m_terrainGrid[gridX][gridZ] = type;
+    m_terrainMap.set(gridX, gridZ, type);
     
     // 如果涉及水面变化，更新网格
-    if (oldType == TerrainType::WATER || type == TerrainType::WATER) {
-        updateWaterMesh();
+    bool waterChanged = (oldType == TerrainType::WATER || type == TerrainType::WATER);
+    markTerrainDirty(gridX, gridZ, waterChanged);
+    if (waterChanged) {
+        queueWaterCell(gridX, gridZ);
     }
     
     std::cout << "Placed terrain " << static_cast<int>(type) << " at (" << gridX << "," << gridZ << ")" << std::endl;
@@ -444,7 +627,7 @@ void SceneEditor::placeObject(ObjectType type, const glm::vec3& position) {
     gridZ = static_cast<int>(std::floor(position.z / cell + GRID_SIZE / 2.0f));
     
     if (gridX >= 0 && gridX < GRID_SIZE && gridZ >= 0 && gridZ < GRID_SIZE) {
-        TerrainType tType = m_terrainGrid[gridX][gridZ];
+        TerrainType tType = m_terrainMap.get(gridX, gridZ);
         bool isWater = (tType == TerrainType::WATER);
         
         bool canBeOnWater = (type == ObjectType::BOAT || 
@@ -516,10 +699,12 @@ void SceneEditor::undoLastAction() {
         TerrainAction action = m_terrainHistory.back();
         m_terrainHistory.pop_back();
         
-        m_terrainGrid[action.gridX][action.gridZ] = action.oldType;
+        m_terrainMap.set(action.gridX, action.gridZ, action.oldType);
         
-        if (action.oldType == TerrainType::WATER || action.newType == TerrainType::WATER) {
-            updateWaterMesh();
+        bool waterChanged = (action.oldType == TerrainType::WATER || action.newType == TerrainType::WATER);
+        markTerrainDirty(action.gridX, action.gridZ, waterChanged);
+        if (waterChanged) {
+            queueWaterCell(action.gridX, action.gridZ);
         }
         std::cout << "Undid terrain action." << std::endl;
     }
@@ -577,8 +762,39 @@ Camera* SceneEditor::getCurrentCamera() {
 }
 
 TerrainType SceneEditor::getTerrainAt(int gridX, int gridZ) const {
-    if (gridX < 0 || gridX >= GRID_SIZE || gridZ < 0 || gridZ >= GRID_SIZE) return TerrainType::EMPTY;
-    return m_terrainGrid[gridX][gridZ];
+    return m_terrainMap.getChecked(gridX, gridZ);
+}
+
+unsigned int SceneEditor::getTerrainChunkGeneration(int chunkX, int chunkZ) const {
+    if (chunkX < 0 || chunkX >= TERRAIN_CHUNK_COUNT || chunkZ < 0 || chunkZ >= TERRAIN_CHUNK_COUNT) {
+        return m_terrainGeneration;
+    }
+    return m_chunkGeneration[chunkX][chunkZ];
+}
+
+void SceneEditor::markTerrainDirty(int gridX, int gridZ, bool waterChanged) {
+    ++m_terrainGeneration;
+    m_chunkGeneration[gridX / TERRAIN_CHUNK_SIZE][gridZ / TERRAIN_CHUNK_SIZE] = m_terrainGeneration;
+    
+    // 水陆切换会让相邻陆地格子生成/移除河岸墙，邻格可能位于另一个块
+    if (waterChanged) {
+        const int directions[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const auto& dir : directions) {
+            int nx = gridX + dir[0];
+            int nz = gridZ + dir[1];
+            if (nx < 0 || nx >= GRID_SIZE || nz < 0 || nz >= GRID_SIZE) continue;
+            m_chunkGeneration[nx / TERRAIN_CHUNK_SIZE][nz / TERRAIN_CHUNK_SIZE] = m_terrainGeneration;
+        }
+    }
+}
+
+void SceneEditor::markAllTerrainDirty() {
+    ++m_terrainGeneration;
+    for (int cx = 0; cx < TERRAIN_CHUNK_COUNT; ++cx) {
+        for (int cz = 0; cz < TERRAIN_CHUNK_COUNT; ++cz) {
+            m_chunkGeneration[cx][cz] = m_terrainGeneration;
+        }
+    }
 }
 
 bool SceneEditor::isWaterAt(int gridX, int gridZ) const {
@@ -699,7 +915,7 @@ bool SceneEditor::saveScene(const std::string& filename) {
     out << GRID_SIZE << "\n";
     for(int i=0; i<GRID_SIZE; ++i) {
         for(int j=0; j<GRID_SIZE; ++j) {
-            out << (int)m_terrainGrid[i][j] << " ";
+            out << (int)m_terrainMap.get(i, j) << " ";
         }
         out << "\n";
     }
@@ -718,9 +934,10 @@ bool SceneEditor::loadScene(const std::string& filename) {
     if (size != GRID_SIZE) return false;
     for(int i=0; i<GRID_SIZE; ++i) {
         for(int j=0; j<GRID_SIZE; ++j) {
-            int t; in >> t; m_terrainGrid[i][j] = (TerrainType)t;
+            int t; in >> t; m_terrainMap.set(i, j, (TerrainType)t);
         }
     }
+    markAllTerrainDirty();
     int count;
     in >> count;
     m_placedObjects.clear();
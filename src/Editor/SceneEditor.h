@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include "TerrainMap.h"
 
 namespace WaterTown {
 
@@ -62,6 +63,14 @@ enum class ObjectType {
     STONE_LION      // 石狮子
 };
 
+/**
+ * @brief 水面几何的生成方式
+ */
+enum class WaterMeshMode {
+    MASK,           // 规则网格 + 逐格遮罩纹理（默认，编辑只更新 1 个纹素）
+    MERGED_MESH     // 水格子按分块合并为矩形（需要贴合岸线的几何时使用，编辑只改写受影响分块）
+};
+
 /**
  * @brief 场景编辑器，管理不同编辑模式和相机切换
  */
@@ -70,6 +79,8 @@ public:
     static constexpr int GRID_SIZE = 320;   // 扩大到 320x320
     static constexpr float CELL_SIZE = 0.5f;
     static constexpr float WATER_LEVEL = 0.0f;
+    static constexpr int TERRAIN_CHUNK_SIZE = 32;  // 地形分块大小（格子数），渲染器按块增量重建
+    static constexpr int TERRAIN_CHUNK_COUNT = (GRID_SIZE + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
 
     SceneEditor();
     ~SceneEditor();
@@ -147,6 +158,23 @@ public:
      */
     TerrainType getTerrainAt(int gridX, int gridZ) const;
     
+    /**
+     * @brief 获取紧凑地形网格（含按类型的位平面，供网格生成和统计批量读取）
+     */
+    const TerrainMap& getTerrainMap() const { return m_terrainMap; }
+    
+    /**
+     * @brief 获取地形数据版本号（网格每次实际变化时递增，渲染器据此判断缓存是否过期）
+     */
+    unsigned int getTerrainGeneration() const { return m_terrainGeneration; }
+    
+    /**
+     * @brief 获取指定地形块的版本号（块内格子或相邻河岸墙变化时更新）
+     * @param chunkX 块 X 索引
+     * @param chunkZ 块 Z 索引
+     */
+    unsigned int getTerrainChunkGeneration(int chunkX, int chunkZ) const;
+    
     /**
      * @brief 获取当前选中的地形类型
      */
@@ -216,6 +244,42 @@ public:
      */
     void updateWaterMesh();
     
+    /**
+     * @brief 设置/获取水面几何生成方式，切换时立即重建
+     */
+    void setWaterMeshMode(WaterMeshMode mode);
+    WaterMeshMode getWaterMeshMode() const { return m_waterMeshMode; }
+    
+    /**
+     * @brief 最近一次划分得到的连通水域数与使用的波浪组数（统计面板显示）
+     */
+    int getWaterRegionCount() const { return m_waterRegionCount; }
+    int getWaterWaveSetCount() const { return m_waterWaveSetCount; }
+    
+    /**
+     * @brief 启用/关闭船只浮力使用的波浪高度场缓存（每帧围绕船只计算一次）
+     */
+    void setWaterHeightfieldEnabled(bool enabled);
+    bool isWaterHeightfieldEnabled() const;
+    
+    /**
+     * @brief 切换 FFT 海浪（关闭时使用 Gerstner 波叠加），渲染和船只浮力同时切换
+     */
+    void setWaterFftOceanEnabled(bool enabled);
+    bool isWaterFftOceanEnabled() const;
+    
+    /**
+     * @brief 启用/关闭船只尾迹模拟
+     */
+    void setWaterWakeEnabled(bool enabled);
+    bool isWaterWakeEnabled() const;
+    
+    /**
+     * @brief 启用/关闭跟随相机的水面 LOD 网格（仅遮罩模式的规则网格使用）
+     */
+    void setWaterClipmapEnabled(bool enabled);
+    bool isWaterClipmapEnabled() const;
+    
     /**
      * @brief 删除最近放置的建筑物
      */
@@ -307,7 +371,49 @@ private:
     ObjectRenderer* m_objectRenderer;
 
     // 网格数据（简化的地形系统）
-    TerrainType m_terrainGrid[GRID_SIZE][GRID_SIZE];
+    TerrainMap m_terrainMap;
+    unsigned int m_terrainGeneration; // 地形数据版本号
+    unsigned int m_chunkGeneration[TERRAIN_CHUNK_COUNT][TERRAIN_CHUNK_COUNT]; // 每个地形块最后变化时的版本号
+    
+    /**
+     * @brief 标记格子变化，更新其所在块（以及水陆关系变化时相邻格子所在块）的版本号
+     * @param waterChanged 该格子是否在水/非水之间切换（会影响相邻陆地的河岸墙）
+     */
+    void markTerrainDirty(int gridX, int gridZ, bool waterChanged);
+    
+    /**
+     * @brief 整个网格被替换时（加载/重置）标记所有块
+     */
+    void markAllTerrainDirty();
+    
+    WaterMeshMode m_waterMeshMode;
+    int m_waterTileCells;                 // 水面分块边长（格子数）
+    int m_waterTilesPerSide;              // 每边的水面分块数
+    std::vector<int> m_waterTilePatches;  // 分块 -> 分块缓冲中的编号，-1 表示块内没有水
+    std::vector<int> m_pendingWaterCells; // 本帧水陆状态变化的格子 (z * GRID_SIZE + x)
+    bool m_waterRegionsDirty;             // 水陆分布变化后需要重新划分水域
+    int m_waterRegionCount;               // 连通水域数
+    int m_waterWaveSetCount;              // 水域使用的波浪组数
+    
+    /**
+     * @brief 记录水陆状态变化的格子，留到 flushWaterEdits 统一同步
+     */
+    void queueWaterCell(int gridX, int gridZ);
+    
+    /**
+     * @brief 每帧一次：遮罩按包围盒上传一次，合并网格模式只重写受影响分块（及其四邻）的区间
+     */
+    void flushWaterEdits();
+    
+    /**
+     * @brief 重新生成一个水面分块并写入分块缓冲（无水时归还其区间）
+     */
+    void updateWaterTile(int tile);
+    
+    /**
+     * @brief 按连通的水格子划分水域，每块水域按面积分配波浪组（小池塘不再使用河道尺度的波浪）
+     */
+    void updateWaterRegions();
     
     // 河道范围
     int m_riverStartColumn; // 河道起始列
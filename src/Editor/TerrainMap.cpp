@@ -0,0 +1,178 @@
+#include "TerrainMap.h"
+#include "SceneEditor.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace WaterTown {
+
+TerrainMap::TerrainMap(int size)
+    : m_size(size), m_wordsPerRow((size + 63) / 64) {
+    m_cells.resize(m_size * m_size);
+    for (int type = 0; type < TYPE_COUNT; ++type) {
+        m_planes[type].resize(m_size * m_wordsPerRow);
+    }
+    fill(TerrainType::EMPTY);
+}
+
+TerrainType TerrainMap::getChecked(int x, int z) const {
+    if (x < 0 || x >= m_size || z < 0 || z >= m_size) return TerrainType::EMPTY;
+    return get(x, z);
+}
+
+void TerrainMap::set(int x, int z, TerrainType type) {
+    int newType = static_cast<int>(type);
+    if (newType < 0 || newType >= TYPE_COUNT) {
+        newType = static_cast<int>(TerrainType::EMPTY); // 非法数据（如损坏的存档）按空地处理
+    }
+
+    uint8_t& cell = m_cells[z * m_size + x];
+    int oldType = cell;
+    if (oldType == newType) return;
+
+    uint64_t bit = uint64_t(1) << (x & 63);
+    int word = x >> 6;
+    planeRow(oldType, z)[word] &= ~bit;
+    planeRow(newType, z)[word] |= bit;
+    --m_counts[oldType];
+    ++m_counts[newType];
+    cell = static_cast<uint8_t>(newType);
+}
+
+void TerrainMap::fill(TerrainType type) {
+    int typeInt = static_cast<int>(type);
+    std::fill(m_cells.begin(), m_cells.end(), static_cast<uint8_t>(typeInt));
+
+    // 满行掩码，行尾多余的位保持为 0
+    std::vector<uint64_t> fullRow(m_wordsPerRow, ~uint64_t(0));
+    if (m_size % 64 != 0) {
+        fullRow[m_wordsPerRow - 1] = (uint64_t(1) << (m_size % 64)) - 1;
+    }
+
+    for (int t = 0; t < TYPE_COUNT; ++t) {
+        for (int z = 0; z < m_size; ++z) {
+            uint64_t* row = planeRow(t, z);
+            for (int w = 0; w < m_wordsPerRow; ++w) {
+                row[w] = (t == typeInt) ? fullRow[w] : 0;
+            }
+        }
+        m_counts[t] = (t == typeInt) ? m_size * m_size : 0;
+    }
+}
+
+void TerrainMap::generateDefaultLayout(int& outRiverStart, int& outRiverEnd) {
+    fill(TerrainType::WATER); // 先铺满水，类似威尼斯/江南
+    
+    // 定义河道宽度和岸线厚度
+    const int riverWidth = static_cast<int>(m_size * 0.25f);   // 中央河道宽 25%
+    const int bankWidth = 3;                                    // 石质河岸厚度
+    const int center = m_size / 2;
+    outRiverStart = center - riverWidth / 2;
+    outRiverEnd = outRiverStart + riverWidth;
+    
+    // 生成陆地
+    for (int x = 0; x < m_size; ++x) {
+        TerrainType columnType;
+        if (x >= outRiverStart && x < outRiverEnd) {
+            columnType = TerrainType::WATER; // 河道
+        }
+        else if ((x >= outRiverStart - bankWidth && x < outRiverStart) ||
+                 (x >= outRiverEnd && x < outRiverEnd + bankWidth)) {
+            columnType = TerrainType::STONE; // 石砌河岸
+        }
+        else {
+            columnType = TerrainType::GRASS; // 城镇陆地
+        }
+        
+        for (int z = 0; z < m_size; ++z) {
+            set(x, z, columnType);
+        }
+    }
+    
+    // 在石岸上加几段码头/广场
+    int plazaDepth = m_size / 5;
+    for (int z = m_size / 3; z < m_size / 3 + plazaDepth; ++z) {
+        for (int x = outRiverStart - bankWidth - 3; x < outRiverStart - bankWidth; ++x) {
+            if (x >= 0) set(x, z, TerrainType::STONE);
+        }
+        for (int x = outRiverEnd + bankWidth; x < outRiverEnd + bankWidth + 3; ++x) {
+            if (x < m_size) set(x, z, TerrainType::STONE);
+        }
+    }
+}
+
+const uint64_t* TerrainMap::getRow(TerrainType type, int z) const {
+    return planeRow(static_cast<int>(type), z);
+}
+
+void TerrainMap::computeLandRow(int z, uint64_t* outMask) const {
+    const uint64_t* grass = planeRow(static_cast<int>(TerrainType::GRASS), z);
+    const uint64_t* stone = planeRow(static_cast<int>(TerrainType::STONE), z);
+    for (int w = 0; w < m_wordsPerRow; ++w) {
+        outMask[w] = grass[w] | stone[w];
+    }
+}
+
+void TerrainMap::computeBankEdges(int z, Direction dir, uint64_t* outMask) const {
+    const int water = static_cast<int>(TerrainType::WATER);
+    computeLandRow(z, outMask);
+
+    switch (dir) {
+        case POS_X: {
+            // 邻居 x+1：整行右移一位，高位从下一个字借入
+            const uint64_t* row = planeRow(water, z);
+            for (int w = 0; w < m_wordsPerRow; ++w) {
+                uint64_t carry = (w + 1 < m_wordsPerRow) ? (row[w + 1] << 63) : 0;
+                outMask[w] &= (row[w] >> 1) | carry;
+            }
+            break;
+        }
+        case NEG_X: {
+            // 邻居 x-1：整行左移一位，低位从上一个字借入
+            const uint64_t* row = planeRow(water, z);
+            for (int w = 0; w < m_wordsPerRow; ++w) {
+                uint64_t carry = (w > 0) ? (row[w - 1] >> 63) : 0;
+                outMask[w] &= (row[w] << 1) | carry;
+            }
+            break;
+        }
+        case POS_Z:
+        case NEG_Z: {
+            int neighborZ = (dir == POS_Z) ? z + 1 : z - 1;
+            if (neighborZ < 0 || neighborZ >= m_size) {
+                std::fill(outMask, outMask + m_wordsPerRow, 0);
+                break;
+            }
+            const uint64_t* row = planeRow(water, neighborZ);
+            for (int w = 0; w < m_wordsPerRow; ++w) {
+                outMask[w] &= row[w];
+            }
+            break;
+        }
+        default:
+            std::fill(outMask, outMask + m_wordsPerRow, 0);
+            break;
+    }
+}
+
+int TerrainMap::lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+int TerrainMap::popCount(uint64_t word) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+} // namespace WaterTown
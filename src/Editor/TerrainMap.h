@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+enum class TerrainType;
+
+/**
+ * @brief 紧凑地形网格：每格 1 字节类型 + 每种类型一张位平面
+ *
+ * 位平面按 Z 行存储，每行 wordsPerRow 个 64 位字，第 x 位表示 (x, z)。
+ * 行尾多余的位恒为 0，因此整字移位做邻居判断时越界格子自然视为 EMPTY。
+ */
+class TerrainMap {
+public:
+    static constexpr int TYPE_COUNT = 4;
+    
+    /**
+     * @brief 邻居方向
+     */
+    enum Direction {
+        POS_X = 0,
+        NEG_X,
+        POS_Z,
+        NEG_Z,
+        DIRECTION_COUNT
+    };
+    
+    explicit TerrainMap(int size);
+    
+    int getSize() const { return m_size; }
+    int getWordsPerRow() const { return m_wordsPerRow; }
+    
+    /**
+     * @brief 读取格子类型（调用方保证坐标合法）
+     */
+    TerrainType get(int x, int z) const { return static_cast<TerrainType>(m_cells[z * m_size + x]); }
+    
+    /**
+     * @brief 读取格子类型，越界返回 EMPTY
+     */
+    TerrainType getChecked(int x, int z) const;
+    
+    /**
+     * @brief 设置格子类型，同步更新位平面和计数
+     */
+    void set(int x, int z, TerrainType type);
+    
+    /**
+     * @brief 整个网格填充为同一类型
+     */
+    void fill(TerrainType type);
+    
+    /**
+     * @brief 生成默认的江南布局：中央河道、两侧石岸与码头广场，其余为草地
+     * @param outRiverStart 输出河道起始列
+     * @param outRiverEnd 输出河道结束列（不含）
+     */
+    void generateDefaultLayout(int& outRiverStart, int& outRiverEnd);
+    
+    /**
+     * @brief 某类型的格子数量
+     */
+    int count(TerrainType type) const { return m_counts[static_cast<int>(type)]; }
+    
+    /**
+     * @brief 获取某类型在第 z 行的位掩码（wordsPerRow 个字）
+     */
+    const uint64_t* getRow(TerrainType type, int z) const;
+    
+    /**
+     * @brief 计算第 z 行中"有顶面的陆地（草地/石路）且 dir 方向邻居为水"的格子掩码
+     * @param z 行号
+     * @param dir 邻居方向
+     * @param outMask 输出，长度 wordsPerRow
+     */
+    void computeBankEdges(int z, Direction dir, uint64_t* outMask) const;
+    
+    /**
+     * @brief 计算第 z 行中有顶面的陆地（草地/石路）掩码
+     */
+    void computeLandRow(int z, uint64_t* outMask) const;
+    
+    /**
+     * @brief 64 位字中最低置位的索引 / 置位数（可移植封装）
+     */
+    static int lowestBit(uint64_t word);
+    static int popCount(uint64_t word);
+
+private:
+    int m_size;
+    int m_wordsPerRow;
+    std::vector<uint8_t> m_cells;                  // z * size + x
+    std::vector<uint64_t> m_planes[TYPE_COUNT];    // (z * wordsPerRow + word)
+    int m_counts[TYPE_COUNT];
+    
+    uint64_t* planeRow(int type, int z) { return &m_planes[type][z * m_wordsPerRow]; }
+    const uint64_t* planeRow(int type, int z) const { return &m_planes[type][z * m_wordsPerRow]; }
+};
+
+} // namespace WaterTown
@@ -83,10 +83,16 @@ void Boat::updateBuoyancy(WaterSurface* waterSurface, float currentTime) {
     glm::vec3 portSide = m_position - right * (BOAT_WIDTH * 0.5f);    // 左舷
     glm::vec3 starboard = m_position + right * (BOAT_WIDTH * 0.5f);   // 右舷
     
-    float heightBow = sampleWaterHeight(bow, waterSurface, currentTime);
-    float heightStern = sampleWaterHeight(stern, waterSurface, currentTime);
-    float heightPort = sampleWaterHeight(portSide, waterSurface, currentTime);
-    float heightStarboard = sampleWaterHeight(starboard, waterSurface, currentTime);
+    // 四个采样点一次批量查询
+    const float xs[4] = {bow.x, stern.x, portSide.x, starboard.x};
+    const float zs[4] = {bow.z, stern.z, portSide.z, starboard.z};
+    float heights[4];
+    waterSurface->getWaterHeights(xs, zs, 4, currentTime, heights);
+    
+    float heightBow = heights[0];
+    float heightStern = heights[1];
+    float heightPort = heights[2];
+    float heightStarboard = heights[3];
     
     // 船体中心高度（平均值）
     float avgHeight = (heightBow + heightStern + heightPort + heightStarboard) / 4.0f;
@@ -103,10 +109,6 @@ void Boat::updateBuoyancy(WaterSurface* waterSurface, float currentTime) {
     m_roll = m_roll * 0.5f + waterRoll * 0.5f;  // 混合水波和运动摇晃
 }
 
-float Boat::sampleWaterHeight(const glm::vec3& worldPos, WaterSurface* waterSurface, float time) const {
-    return waterSurface->getWaterHeight(worldPos.x, worldPos.z, time);
-}
-
 void Boat::addObstacle(const glm::vec3& position, float radius) {
     m_obstacles.push_back({position, radius});
 }
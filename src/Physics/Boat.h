@@ -58,6 +58,12 @@ public:
      */
     float getSpeed() const { return m_speed; }
     
+    /**
+     * @brief 获取船体尺寸（长、宽）
+     */
+    float getLength() const { return BOAT_LENGTH; }
+    float getWidth() const { return BOAT_WIDTH; }
+    
     /**
      * @brief 获取船体倾斜角度（俯仰和翻滚）
      */
@@ -153,11 +159,6 @@ private:
      */
     void updateBuoyancy(WaterSurface* waterSurface, float currentTime);
     
-    /**
-     * @brief 计算采样点的水面高度
-     */
-    float sampleWaterHeight(const glm::vec3& worldPos, WaterSurface* waterSurface, float time) const;
-    
     /**
      * @brief 检查并处理碰撞
      */
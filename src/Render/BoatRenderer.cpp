@@ -2,6 +2,7 @@
 #include "ModelLoader.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "RenderState.h"
 #include "../Physics/Boat.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -238,17 +239,11 @@ void BoatRenderer::render(const Boat* boat, Shader* shader, Camera* camera) {
     
     // 设置着色器 uniform
     shader->setMat4("uModel", model);
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-    shader->setVec3("uLightPos", 10.0f, 10.0f, 10.0f);
-    shader->setVec3("uLightColor", 1.0f, 1.0f, 1.0f);
     shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 棕色
     
     // 渲染网格
-    glBindVertexArray(m_boatMesh->VAO);
+    RenderState::bindVertexArray(m_boatMesh->VAO);
     glDrawElements(GL_TRIANGLES, m_boatMesh->indices.size(), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
 }
 
 } // namespace WaterTown
@@ -0,0 +1,55 @@
+#include "FrameUniforms.h"
+#include "Camera.h"
+#include "RenderState.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstring>
+
+namespace WaterTown {
+
+FrameUniforms::FrameUniforms()
+    : m_UBO(0), m_lightPos(10.0f, 50.0f, 10.0f), m_lightColor(1.0f, 1.0f, 1.0f) {
+    static_assert(sizeof(Block) == 176, "Block must match the std140 layout of FrameUniforms");
+    std::memset(&m_block, 0, sizeof(m_block));
+}
+
+FrameUniforms::~FrameUniforms() {
+    if (m_UBO) RenderState::deleteBuffers(1, &m_UBO);
+}
+
+void FrameUniforms::setLight(const glm::vec3& position, const glm::vec3& color) {
+    m_lightPos = position;
+    m_lightColor = color;
+}
+
+void FrameUniforms::update(const Camera* camera) {
+    if (!camera) return;
+    
+    Block block;
+    std::memset(&block, 0, sizeof(block));
+    glm::mat4 view = camera->getViewMatrix();
+    glm::mat4 projection = camera->getProjectionMatrix();
+    glm::vec3 viewPos = camera->getPosition();
+    std::memcpy(block.view, glm::value_ptr(view), sizeof(block.view));
+    std::memcpy(block.projection, glm::value_ptr(projection), sizeof(block.projection));
+    std::memcpy(block.viewPos, glm::value_ptr(viewPos), sizeof(block.viewPos));
+    std::memcpy(block.lightPos, glm::value_ptr(m_lightPos), sizeof(block.lightPos));
+    std::memcpy(block.lightColor, glm::value_ptr(m_lightColor), sizeof(block.lightColor));
+    
+    if (m_UBO == 0) {
+        glGenBuffers(1, &m_UBO);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), &block, GL_DYNAMIC_DRAW);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_block = block;
+    } else if (std::memcmp(&block, &m_block, sizeof(Block)) != 0) {
+        // 相机静止时跳过上传
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, m_UBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &block);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_block = block;
+    }
+    
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, m_UBO);
+}
+
+} // namespace WaterTown
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace WaterTown {
+
+class Camera;
+
+/**
+ * @brief 所有着色器共用的每帧参数（相机矩阵、相机位置、光源），std140 uniform 块 FrameUniforms
+ *
+ * 每帧从当前相机更新一次，内容不变时不上传。Shader 链接后把 FrameUniforms 块绑定到 BINDING，
+ * 各渲染器不再逐个程序设置 uView / uProjection / uViewPos / uLightPos / uLightColor。
+ */
+class FrameUniforms {
+public:
+    /**
+     * @brief 各 .vert / .frag 中 FrameUniforms uniform 块使用的绑定点
+     */
+    static const unsigned int BINDING = 0;
+    
+    FrameUniforms();
+    ~FrameUniforms();
+    
+    // 禁止拷贝
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+    
+    /**
+     * @brief 设置点光源（所有着色器共用）
+     */
+    void setLight(const glm::vec3& position, const glm::vec3& color);
+    
+    /**
+     * @brief 从相机更新并绑定到 BINDING（每帧渲染前调用一次）
+     */
+    void update(const Camera* camera);
+
+private:
+    /**
+     * @brief FrameUniforms 块的 CPU 镜像（std140 布局，填充字段显式写出，便于整体比较）
+     */
+    struct Block {
+        float view[16];
+        float projection[16];
+        float viewPos[3];
+        float padding0;
+        float lightPos[3];
+        float padding1;
+        float lightColor[3];
+        float padding2;
+    };
+    
+    unsigned int m_UBO;
+    Block m_block;      // 最近一次上传的内容
+    glm::vec3 m_lightPos;
+    glm::vec3 m_lightColor;
+};
+
+} // namespace WaterTown
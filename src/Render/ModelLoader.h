@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include "RenderState.h"
 #include <string>
 #include <vector>
 
@@ -18,9 +19,9 @@ struct Mesh {
     Mesh() : VAO(0), VBO(0), EBO(0) {}
     
     ~Mesh() {
-        if (VAO) glDeleteVertexArrays(1, &VAO);
-        if (VBO) glDeleteBuffers(1, &VBO);
-        if (EBO) glDeleteBuffers(1, &EBO);
+        if (VAO) RenderState::deleteVertexArrays(1, &VAO);
+        if (VBO) RenderState::deleteBuffers(1, &VBO);
+        if (EBO) RenderState::deleteBuffers(1, &EBO);
     }
     
     void setupMesh() {
@@ -28,11 +29,11 @@ struct Mesh {
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
         
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        RenderState::bindVertexArray(VAO);
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        RenderState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
         
         // 位置属性
@@ -43,7 +44,7 @@ struct Mesh {
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(1);
         
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
     }
 };
 
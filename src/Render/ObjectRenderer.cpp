@@ -1,9 +1,11 @@
 #include "ObjectRenderer.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "RenderState.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 #include <cmath>
+#include <cstddef>
 
 namespace WaterTown {
 
@@ -11,6 +13,9 @@ ObjectRenderer::ObjectRenderer()
     : m_cubeVAO(0), m_cubeVBO(0), m_coneVAO(0), m_coneVBO(0),
       m_cylinderVAO(0), m_cylinderVBO(0), m_sphereVAO(0), m_sphereVBO(0),
       m_coneVertexCount(0), m_cylinderVertexCount(0), m_sphereVertexCount(0) {
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        m_instanceVBOs[i] = 0;
+    }
     
     generateCube();
     generateCone();
@@ -19,14 +24,17 @@ ObjectRenderer::ObjectRenderer()
 }
 
 ObjectRenderer::~ObjectRenderer() {
-    if (m_cubeVAO) glDeleteVertexArrays(1, &m_cubeVAO);
-    if (m_cubeVBO) glDeleteBuffers(1, &m_cubeVBO);
-    if (m_coneVAO) glDeleteVertexArrays(1, &m_coneVAO);
-    if (m_coneVBO) glDeleteBuffers(1, &m_coneVBO);
-    if (m_cylinderVAO) glDeleteVertexArrays(1, &m_cylinderVAO);
-    if (m_cylinderVBO) glDeleteBuffers(1, &m_cylinderVBO);
-    if (m_sphereVAO) glDeleteVertexArrays(1, &m_sphereVAO);
-    if (m_sphereVBO) glDeleteBuffers(1, &m_sphereVBO);
+    if (m_cubeVAO) RenderState::deleteVertexArrays(1, &m_cubeVAO);
+    if (m_cubeVBO) RenderState::deleteBuffers(1, &m_cubeVBO);
+    if (m_coneVAO) RenderState::deleteVertexArrays(1, &m_coneVAO);
+    if (m_coneVBO) RenderState::deleteBuffers(1, &m_coneVBO);
+    if (m_cylinderVAO) RenderState::deleteVertexArrays(1, &m_cylinderVAO);
+    if (m_cylinderVBO) RenderState::deleteBuffers(1, &m_cylinderVBO);
+    if (m_sphereVAO) RenderState::deleteVertexArrays(1, &m_sphereVAO);
+    if (m_sphereVBO) RenderState::deleteBuffers(1, &m_sphereVBO);
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        if (m_instanceVBOs[i]) RenderState::deleteBuffers(1, &m_instanceVBOs[i]);
+    }
 }
 
 void ObjectRenderer::generateCube() {
@@ -79,8 +87,8 @@ void ObjectRenderer::generateCube() {
     glGenVertexArrays(1, &m_cubeVAO);
     glGenBuffers(1, &m_cubeVBO);
     
-    glBindVertexArray(m_cubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
+    RenderState::bindVertexArray(m_cubeVAO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -88,7 +96,9 @@ void ObjectRenderer::generateCube() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    setupInstanceAttributes(Primitive::CUBE, m_cubeVAO);
+    
+    RenderState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateCone() {
@@ -126,8 +136,8 @@ void ObjectRenderer::generateCone() {
     glGenVertexArrays(1, &m_coneVAO);
     glGenBuffers(1, &m_coneVBO);
     
-    glBindVertexArray(m_coneVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_coneVBO);
+    RenderState::bindVertexArray(m_coneVAO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_coneVBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -135,7 +145,9 @@ void ObjectRenderer::generateCone() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    setupInstanceAttributes(Primitive::CONE, m_coneVAO);
+    
+    RenderState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateCylinder() {
@@ -182,8 +194,8 @@ void ObjectRenderer::generateCylinder() {
     glGenVertexArrays(1, &m_cylinderVAO);
     glGenBuffers(1, &m_cylinderVBO);
     
-    glBindVertexArray(m_cylinderVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_cylinderVBO);
+    RenderState::bindVertexArray(m_cylinderVAO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_cylinderVBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -191,7 +203,9 @@ void ObjectRenderer::generateCylinder() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    setupInstanceAttributes(Primitive::CYLINDER, m_cylinderVAO);
+    
+    RenderState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateSphere() {
@@ -245,8 +259,8 @@ void ObjectRenderer::generateSphere() {
     glGenVertexArrays(1, &m_sphereVAO);
     glGenBuffers(1, &m_sphereVBO);
     
-    glBindVertexArray(m_sphereVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_sphereVBO);
+    RenderState::bindVertexArray(m_sphereVAO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_sphereVBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -254,7 +268,51 @@ void ObjectRenderer::generateSphere() {
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    setupInstanceAttributes(Primitive::SPHERE, m_sphereVAO);
+    
+    RenderState::bindVertexArray(0);
+}
+
+void ObjectRenderer::setupInstanceAttributes(Primitive primitive, GLuint vao) {
+    GLuint& instanceVBO = m_instanceVBOs[static_cast<int>(primitive)];
+    glGenBuffers(1, &instanceVBO);
+    
+    RenderState::bindVertexArray(vao);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    
+    // 逐部件颜色
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectInstance),
+                          (void*)offsetof(ObjectInstance, color));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    
+    // 模型矩阵按列占 3~6 四个位置
+    for (int column = 0; column < 4; ++column) {
+        GLuint location = 3 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(ObjectInstance),
+                              (void*)(offsetof(ObjectInstance, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+GLsizei ObjectRenderer::getVertexCount(Primitive primitive) const {
+    switch (primitive) {
+        case Primitive::CUBE:
+            return 36;
+        case Primitive::CONE:
+            return static_cast<GLsizei>(m_coneVertexCount);
+        case Primitive::CYLINDER:
+            return static_cast<GLsizei>(m_cylinderVertexCount);
+        case Primitive::SPHERE:
+            return static_cast<GLsizei>(m_sphereVertexCount);
+        default:
+            return 0;
+    }
+}
+
+void ObjectRenderer::addInstance(Primitive primitive, const glm::mat4& model, const glm::vec3& color) {
+    m_instances[static_cast<int>(primitive)].push_back({color, model});
 }
 
 void ObjectRenderer::addObject(ObjectType type, const glm::vec3& position, float rotation) {
@@ -268,86 +326,103 @@ void ObjectRenderer::clear() {
 void ObjectRenderer::render(Shader* shader, Camera* camera) {
     if (!shader || !camera) return;
     
-    shader->use();
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-    shader->setVec3("uLightPos", 10.0f, 10.0f, 10.0f);
-    shader->setVec3("uLightColor", 1.0f, 1.0f, 1.0f);
+    // 先把所有物体拆成部件实例，按几何体归类
+    for (auto& instances : m_instances) {
+        instances.clear();
+    }
     
     for (const auto& obj : m_objects) {
         switch (obj.type) {
             case ObjectType::HOUSE:
-                renderHouse(obj.position, obj.rotation, shader);
+                renderHouse(obj.position, obj.rotation);
                 break;
             case ObjectType::HOUSE_STYLE_1:
-                renderHouseStyle1(obj.position, obj.rotation, shader);
+                renderHouseStyle1(obj.position, obj.rotation);
                 break;
             case ObjectType::HOUSE_STYLE_2:
-                renderHouseStyle2(obj.position, obj.rotation, shader);
+                renderHouseStyle2(obj.position, obj.rotation);
                 break;
             case ObjectType::HOUSE_STYLE_3:
-                renderHouseStyle3(obj.position, obj.rotation, shader);
+                renderHouseStyle3(obj.position, obj.rotation);
                 break;
             case ObjectType::HOUSE_STYLE_4:
-                renderHouseStyle4(obj.position, obj.rotation, shader);
+                renderHouseStyle4(obj.position, obj.rotation);
                 break;
             case ObjectType::HOUSE_STYLE_5:
-                renderHouseStyle5(obj.position, obj.rotation, shader);
+                renderHouseStyle5(obj.position, obj.rotation);
                 break;
             case ObjectType::BRIDGE:
-                renderBridge(obj.position, obj.rotation, shader);
+                renderBridge(obj.position, obj.rotation);
                 break;
             case ObjectType::TREE:
-                renderTree(obj.position, obj.rotation, shader);
+                renderTree(obj.position, obj.rotation);
                 break;
             case ObjectType::BOAT:
                 // 船由 BoatRenderer 单独处理
                 break;
             case ObjectType::WALL:
-                renderWall(obj.position, obj.rotation, shader);
+                renderWall(obj.position, obj.rotation);
                 break;
             case ObjectType::PAVILION:
-                renderPavilion(obj.position, obj.rotation, shader);
+                renderPavilion(obj.position, obj.rotation);
                 break;
             case ObjectType::LONG_HOUSE:
-                renderLongHouse(obj.position, obj.rotation, shader);
+                renderLongHouse(obj.position, obj.rotation);
                 break;
             case ObjectType::ARCH_BRIDGE:
-                renderArchBridge(obj.position, obj.rotation, shader);
+                renderArchBridge(obj.position, obj.rotation);
                 break;
             case ObjectType::PAIFANG:
-                renderPaifang(obj.position, obj.rotation, shader);
+                renderPaifang(obj.position, obj.rotation);
                 break;
             case ObjectType::WATER_PAVILION:
-                renderWaterPavilion(obj.position, obj.rotation, shader);
+                renderWaterPavilion(obj.position, obj.rotation);
                 break;
             case ObjectType::PIER:
-                renderPier(obj.position, obj.rotation, shader);
+                renderPier(obj.position, obj.rotation);
                 break;
             case ObjectType::TEMPLE:
-                renderTemple(obj.position, obj.rotation, shader);
+                renderTemple(obj.position, obj.rotation);
                 break;
             case ObjectType::BAMBOO:
-                renderBamboo(obj.position, obj.rotation, shader);
+                renderBamboo(obj.position, obj.rotation);
                 break;
             case ObjectType::LOTUS_POND:
-                renderLotusPond(obj.position, obj.rotation, shader);
+                renderLotusPond(obj.position, obj.rotation);
                 break;
             case ObjectType::FISHING_BOAT:
-                renderFishingBoat(obj.position, obj.rotation, shader);
+                renderFishingBoat(obj.position, obj.rotation);
                 break;
             case ObjectType::LANTERN:
-                renderLantern(obj.position, obj.rotation, shader);
+                renderLantern(obj.position, obj.rotation);
                 break;
             case ObjectType::STONE_LION:
-                renderStoneLion(obj.position, obj.rotation, shader);
+                renderStoneLion(obj.position, obj.rotation);
                 break;
         }
     }
+    
+    shader->use();  // 相机与光源来自 FrameUniforms 块
+    shader->setBool("uUseVertexColor", true);
+    
+    // 每种几何体一次实例化绘制
+    const GLuint vaos[PRIMITIVE_COUNT] = {m_cubeVAO, m_coneVAO, m_cylinderVAO, m_sphereVAO};
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        const auto& instances = m_instances[i];
+        if (instances.empty()) continue;
+        
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, m_instanceVBOs[i]);
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(ObjectInstance), instances.data(), GL_STREAM_DRAW);
+        
+        RenderState::bindVertexArray(vaos[i]);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, getVertexCount(static_cast<Primitive>(i)),
+                              static_cast<GLsizei>(instances.size()));
+    }
+    
+    shader->setBool("uUseVertexColor", false);
 }
 
-void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation) {
     // 江南水乡特色民居：白墙黑瓦，飞檐翘角，木结构门窗
     
     // 基础尺寸
@@ -366,11 +441,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth, wallHeight, wallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.95f, 0.95f, 0.9f);  // 白灰墙
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.95f, 0.95f, 0.9f));  // 白灰墙
     
     // 2. 屋顶主体（黑瓦）
     model = glm::mat4(1.0f);
@@ -378,11 +449,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang, roofHeight * 0.8f, wallDepth + roofOverhang));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 黑瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.2f, 0.2f, 0.2f));  // 黑瓦
     
     // 3. 飞檐（前檐翘角）
     model = glm::mat4(1.0f);
@@ -390,11 +457,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang * 1.8f, roofHeight * 0.3f, roofOverhang * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.15f, 0.15f, 0.15f);  // 深黑瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.15f, 0.15f, 0.15f));  // 深黑瓦
     
     // 4. 后檐
     model = glm::mat4(1.0f);
@@ -402,9 +465,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang * 1.8f, roofHeight * 0.3f, roofOverhang * 1.2f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.15f, 0.15f, 0.15f));
     
     // 5. 木门（深色）
     model = glm::mat4(1.0f);
@@ -412,11 +473,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 深木色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.3f, 0.2f, 0.1f));  // 深木色
     
     // 6. 窗户（两个侧面窗户）
     for (int i = 0; i < 2; i++) {
@@ -426,11 +483,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.6f, 0.8f);  // 浅蓝色窗户
-        
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addInstance(Primitive::CUBE, model, glm::vec3(0.4f, 0.6f, 0.8f));  // 浅蓝色窗户
     }
     
     // 7. 木柱支撑（四个角）
@@ -442,18 +495,12 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
         model = glm::translate(model, position + glm::vec3(x, wallHeight * 0.5f, z));
         model = glm::scale(model, glm::vec3(0.1f, wallHeight, 0.1f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.2f);  // 木柱色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.4f, 0.3f, 0.2f));  // 木柱色
     }
-    
-    glBindVertexArray(0);
 }
 
 
-void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation) {
     // 长屋 = 扩展的房子，长度更长
     
     // 基础尺寸
@@ -469,11 +516,7 @@ void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation,
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(longHouseLength, houseHeight, houseScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.95f, 0.95f, 0.92f);  // 米白色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.95f, 0.95f, 0.92f));  // 米白色
     
     // 屋顶（锥体）- 放在墙体顶部
     model = glm::mat4(1.0f);
@@ -481,16 +524,10 @@ void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation,
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(longHouseLength * 1.1f, houseRoofHeight, houseRoofScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 灰色
-    
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CONE, model, glm::vec3(0.5f, 0.5f, 0.5f));  // 灰色
 }
 
-void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation) {
     // 现代中式别墅：融合传统与现代的豪华住宅
     
     // 基础尺寸
@@ -508,11 +545,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(baseWidth, floorHeight, baseDepth));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.85f, 0.85f, 0.8f);  // 浅米色墙
-        
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addInstance(Primitive::CUBE, model, glm::vec3(0.85f, 0.85f, 0.8f));  // 浅米色墙
     }
     
     // 2. 现代中式屋顶（平顶+翘角）
@@ -522,11 +555,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(baseWidth + 0.5f, roofHeight * 0.6f, baseDepth + 0.5f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 深灰瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.2f, 0.2f, 0.2f));  // 深灰瓦
     
     // 翘角装饰
     for (int i = 0; i < 4; i++) {
@@ -538,9 +567,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(0.3f, roofHeight * 0.4f, 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addInstance(Primitive::CUBE, model, glm::vec3(0.2f, 0.2f, 0.2f));
     }
     
     // 3. 玻璃幕墙（现代元素）
@@ -550,11 +577,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(baseWidth * 0.8f, floorHeight * 0.6f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.8f, 0.9f);  // 浅蓝玻璃
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.8f, 0.9f));  // 浅蓝玻璃
     
     // 4. 古典柱子（现代简约风格）
     for (int i = 0; i < 4; i++) {
@@ -565,17 +588,11 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, floorHeight, z));
         model = glm::scale(model, glm::vec3(0.08f, floorHeight * 2, 0.08f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.5f, 0.4f, 0.3f);  // 现代木色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.5f, 0.4f, 0.3f));  // 现代木色
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation) {
     // 古朴农舍：简朴的乡村住宅，茅草屋顶
     
     // 基础尺寸
@@ -590,11 +607,7 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth + 0.2f, 0.2f, shedDepth + 0.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 石灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.5f, 0.5f, 0.5f));  // 石灰色
     
     // 2. 木墙主体
     model = glm::mat4(1.0f);
@@ -602,11 +615,7 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth, shedHeight, shedDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 深木色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.4f, 0.2f));  // 深木色
     
     // 3. 茅草屋顶（圆锥形）
     model = glm::mat4(1.0f);
@@ -614,11 +623,7 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth + 0.8f, roofHeight, shedDepth + 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.1f);  // 茅草色
-    
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
+    addInstance(Primitive::CONE, model, glm::vec3(0.4f, 0.3f, 0.1f));  // 茅草色
     
     // 4. 小门
     model = glm::mat4(1.0f);
@@ -626,22 +631,14 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(0.5f, shedHeight * 0.5f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 旧木门
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.3f, 0.2f, 0.1f));  // 旧木门
     
     // 5. 烟囱（小砖砌）
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(shedWidth * 0.3f, shedHeight + roofHeight * 0.8f + 0.1f, 0));
     model = glm::scale(model, glm::vec3(0.15f, roofHeight * 0.4f, 0.15f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.3f, 0.3f);  // 砖红色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.3f, 0.3f));  // 砖红色
     
     // 6. 木柱支撑
     for (int i = 0; i < 4; i++) {
@@ -652,17 +649,11 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, shedHeight * 0.5f + 0.1f, z));
         model = glm::scale(model, glm::vec3(0.08f, shedHeight, 0.08f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.2f);  // 粗糙木色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.4f, 0.3f, 0.2f));  // 粗糙木色
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation) {
     // 石头 = 灰色立方体
     
     // 基础尺寸
@@ -674,16 +665,10 @@ void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation, Sha
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(bridgeScale, bridgeHeight, bridgeScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.6f, 0.6f);  // 灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.6f, 0.6f));  // 灰色
 }
 
-void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderTree(const glm::vec3& position, float rotation) {
     // 树 = 棕色圆柱（树干） + 绿色球体（树冠）
     
     // 基础尺寸
@@ -697,11 +682,7 @@ void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shade
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(treeScale, treeHeight, treeScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.1f);  // 棕色
-    
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addInstance(Primitive::CYLINDER, model, glm::vec3(0.4f, 0.25f, 0.1f));  // 棕色
     
     // 树冠（球体）- 放在树干顶部
     model = glm::mat4(1.0f);
@@ -709,16 +690,10 @@ void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shade
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(treeCrownScale, treeCrownScale, treeCrownScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.7f, 0.2f);  // 绿色
-    
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::SPHERE, model, glm::vec3(0.2f, 0.7f, 0.2f));  // 绿色
 }
 
-void ObjectRenderer::renderWall(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderWall(const glm::vec3& position, float rotation) {
     // 围墙 = 灰色长方体
     
     // 基础尺寸
@@ -731,15 +706,10 @@ void ObjectRenderer::renderWall(const glm::vec3& position, float rotation, Shade
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallLength, wallHeight, wallWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.6f, 0.6f);  // 灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.6f, 0.6f));  // 灰色
 }
 
-void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation) {
     // 凉亭 = 红色柱子 + 绿色屋顶
     float pavilionSize = 2.0f;
     float pavilionHeight = 2.5f;
@@ -753,11 +723,7 @@ void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, S
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.2f, pavilionHeight * 0.6f, 0.2f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.8f, 0.3f, 0.3f);  // 红色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.8f, 0.3f, 0.3f));  // 红色
     }
     
     // 屋顶（圆锥）
@@ -765,16 +731,10 @@ void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, S
     model = glm::translate(model, position + glm::vec3(0, pavilionHeight * 0.8f, 0));
     model = glm::scale(model, glm::vec3(pavilionSize * 0.8f, pavilionHeight * 0.4f, pavilionSize * 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.6f, 0.2f);  // 绿色
-    
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CONE, model, glm::vec3(0.2f, 0.6f, 0.2f));  // 绿色
 }
 
-void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation) {
     // 拱桥 = 石灰色桥身 + 拱形结构
     
     // 基础尺寸
@@ -787,11 +747,7 @@ void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation,
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(archBridgeLength, archBridgeHeight * 0.6f, archBridgeWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.7f, 0.7f, 0.6f);  // 石灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.7f, 0.7f, 0.6f));  // 石灰色
     
     // 拱形部分（多个半圆柱）
     for (int i = 0; i < 5; i++) {
@@ -802,15 +758,11 @@ void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation,
         model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0, 0, 1));
         model = glm::scale(model, glm::vec3(archBridgeWidth * 0.3f, archBridgeLength * 0.15f, archBridgeWidth * 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.7f, 0.7f, 0.6f));
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation) {
     // 江南水乡特色民居：两层楼房，带天井
     
     // 基础尺寸
@@ -826,11 +778,7 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth, wallHeight, wallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.9f, 0.85f);  // 白墙
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.9f, 0.9f, 0.85f));  // 白墙
     
     // 2. 二层墙体（更小的）
     model = glm::mat4(1.0f);
@@ -838,9 +786,7 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth * 0.8f, 0.8f, wallDepth * 0.8f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.9f, 0.9f, 0.85f));
     
     // 3. 屋顶（黑瓦）
     model = glm::mat4(1.0f);
@@ -848,11 +794,7 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang, roofHeight, wallDepth + roofOverhang));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.25f, 0.25f, 0.25f);  // 黑瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.25f, 0.25f, 0.25f));  // 黑瓦
     
     // 4. 天井（中间空出的庭院）
     // 底层门廊
@@ -861,11 +803,7 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth * 0.6f, wallHeight * 0.4f, wallDepth * 0.6f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.1f, 0.1f, 0.1f);  // 天井（深色表示阴影）
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.1f, 0.1f, 0.1f));  // 天井（深色表示阴影）
     
     // 5. 柱子（木质）
     for (int i = 0; i < 4; i++) {
@@ -876,17 +814,11 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.1f, wallHeight, 0.1f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.1f);  // 木色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.4f, 0.25f, 0.1f));  // 木色
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation) {
     // 精致庭院住宅：带花园的豪华住宅
     
     // 基础尺寸
@@ -903,11 +835,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(mainWidth, mainHeight, mainDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.85f, 0.85f, 0.8f);  // 浅白墙
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.85f, 0.85f, 0.8f));  // 浅白墙
     
     // 2. 左侧翼
     model = glm::mat4(1.0f);
@@ -915,9 +843,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wingWidth, mainHeight * 0.8f, wingDepth));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.85f, 0.85f, 0.8f));
     
     // 3. 右侧翼
     model = glm::mat4(1.0f);
@@ -925,9 +851,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wingWidth, mainHeight * 0.8f, wingDepth));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.85f, 0.85f, 0.8f));
     
     // 4. 精致屋顶（多层）
     // 主屋顶
@@ -936,11 +860,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(mainWidth + 0.5f, roofHeight * 0.8f, mainDepth + 0.5f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 深黑瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.2f, 0.2f, 0.2f));  // 深黑瓦
     
     // 翼屋顶
     for (int i = 0; i < 2; i++) {
@@ -950,9 +870,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(wingWidth + 0.3f, roofHeight * 0.6f, wingDepth + 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addInstance(Primitive::CUBE, model, glm::vec3(0.2f, 0.2f, 0.2f));
     }
     
     // 5. 花园装饰（小池塘）
@@ -960,16 +878,10 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, 0.05f, mainDepth * 0.7f));
     model = glm::scale(model, glm::vec3(1.5f, 0.1f, 1.0f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.6f, 0.8f);  // 水蓝色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.3f, 0.6f, 0.8f));  // 水蓝色
 }
 
-void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation) {
     // 传统祠堂：庄严肃穆的家族祠堂
     
     // 基础尺寸
@@ -986,11 +898,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth, hallHeight, hallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.75f);  // 古旧白墙
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.8f, 0.8f, 0.75f));  // 古旧白墙
     
     // 2. 门廊
     model = glm::mat4(1.0f);
@@ -998,11 +906,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(porchWidth, hallHeight * 0.6f, porchDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.1f, 0.1f, 0.1f);  // 门廊（深色）
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.1f, 0.1f, 0.1f));  // 门廊（深色）
     
     // 3. 庄重屋顶（多重檐）
     // 底层屋顶
@@ -1011,11 +915,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth + 0.8f, roofHeight * 0.4f, hallDepth + 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.15f, 0.15f, 0.15f);  // 深黑瓦
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.15f, 0.15f, 0.15f));  // 深黑瓦
     
     // 上层屋顶
     model = glm::mat4(1.0f);
@@ -1023,9 +923,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth + 0.4f, roofHeight * 0.3f, hallDepth + 0.4f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.15f, 0.15f, 0.15f));
     
     // 4. 柱子（粗壮的木柱）
     for (int i = 0; i < 6; i++) {
@@ -1036,11 +934,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, hallHeight * 0.5f, z));
         model = glm::scale(model, glm::vec3(0.15f, hallHeight, 0.15f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 深木色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.3f, 0.2f, 0.1f));  // 深木色
     }
     
     // 5. 牌匾位置（装饰性立方体）
@@ -1049,17 +943,11 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(1.0f, 0.3f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.6f, 0.2f);  // 金黄色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.8f, 0.6f, 0.2f));  // 金黄色
 }
 
 
-void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation) {
     // 牌坊 = 红色柱子和横梁
     
     // 基础尺寸
@@ -1071,11 +959,7 @@ void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Sh
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(paifangWidth, paifangHeight, 0.3f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.2f, 0.2f);  // 深红色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.9f, 0.2f, 0.2f));  // 深红色
     
     // 装饰性拱顶
     model = glm::mat4(1.0f);
@@ -1083,14 +967,10 @@ void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Sh
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(paifangWidth * 0.8f, paifangHeight * 0.2f, 0.4f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.9f, 0.2f, 0.2f));
 }
 
-void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotation) {
     // 水榭 = 建在水上的凉亭，带平台
     
     // 基础尺寸
@@ -1102,17 +982,13 @@ void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotati
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(waterPavilionSize, 0.2f, waterPavilionSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.7f);  // 浅灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.8f, 0.8f, 0.7f));  // 浅灰色
     
     // 柱子和屋顶（类似凉亭但更精致）
-    renderPavilion(position + glm::vec3(0, 0.2f, 0), rotation, shader);
+    renderPavilion(position + glm::vec3(0, 0.2f, 0), rotation);
 }
 
-void ObjectRenderer::renderPier(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPier(const glm::vec3& position, float rotation) {
     // 码头 = 木质平台伸入水中
     float pierLength = 3.0f;  // 码头长度
     float pierWidth = 1.5f;   // 码头宽度
@@ -1122,11 +998,7 @@ void ObjectRenderer::renderPier(const glm::vec3& position, float rotation, Shade
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(pierLength, 0.1f, pierWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 木色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.4f, 0.2f));  // 木色
     
     // 支撑柱子
     for (int i = 0; i < 6; i++) {
@@ -1135,15 +1007,11 @@ void ObjectRenderer::renderPier(const glm::vec3& position, float rotation, Shade
         model = glm::translate(model, position + glm::vec3((i - 2.5f) * pierLength * 0.15f, -0.5f, z));
         model = glm::scale(model, glm::vec3(0.1f, 1.0f, 0.1f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.6f, 0.4f, 0.2f));
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation) {
     // 寺庙 = 多层建筑，带屋檐
     
     // 基础尺寸
@@ -1156,11 +1024,7 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(templeSize, templeHeight * 0.8f, templeSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.6f);  // 米色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.8f, 0.8f, 0.6f));  // 米色
     
     // 屋顶
     model = glm::mat4(1.0f);
@@ -1168,16 +1032,10 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(templeSize * 1.2f, templeHeight * 0.3f, templeSize * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.7f, 0.3f, 0.3f);  // 红色屋顶
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.7f, 0.3f, 0.3f));  // 红色屋顶
 }
 
-void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation) {
     // 竹子 = 绿色细长圆柱，带关节
     float bambooHeight = 2.5f;      // 竹子高度
     float bambooDensity = 0.8f;     // 竹子密度
@@ -1187,11 +1045,7 @@ void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation, Sha
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(bambooDensity * 0.1f, bambooHeight, bambooDensity * 0.1f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.8f, 0.3f);  // 竹绿色
-    
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addInstance(Primitive::CYLINDER, model, glm::vec3(0.3f, 0.8f, 0.3f));  // 竹绿色
     
     // 竹节（环状装饰）
     for (int i = 1; i < 4; i++) {
@@ -1200,15 +1054,11 @@ void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation, Sha
         model = glm::translate(model, position + glm::vec3(0, y, 0));
         model = glm::scale(model, glm::vec3(bambooDensity * 0.12f, bambooDensity * 0.02f, bambooDensity * 0.12f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.3f, 0.8f, 0.3f));
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation) {
     // 荷花池 = 水面 + 荷叶 + 荷花
     float lotusPondSize = 3.0f;     // 荷花池大小
     
@@ -1217,11 +1067,7 @@ void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation,
     model = glm::translate(model, position + glm::vec3(0, 0.01f, 0));
     model = glm::scale(model, glm::vec3(lotusPondSize, 0.02f, lotusPondSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.7f, 0.9f);  // 浅蓝色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.4f, 0.7f, 0.9f));  // 浅蓝色
     
     // 荷叶（绿色扁平圆形）
     for (int i = 0; i < 5; i++) {
@@ -1233,17 +1079,11 @@ void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation,
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.5f, 0.01f, 0.5f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.2f, 0.6f, 0.2f);  // 绿色
-        
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addInstance(Primitive::CYLINDER, model, glm::vec3(0.2f, 0.6f, 0.2f));  // 绿色
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderFishingBoat(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderFishingBoat(const glm::vec3& position, float rotation) {
     // 渔船 = 小型船只，带桅杆
     float fishingBoatLength = 2.5f; // 渔船长度
     float fishingBoatWidth = 0.8f;  // 渔船宽度
@@ -1254,25 +1094,17 @@ void ObjectRenderer::renderFishingBoat(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(fishingBoatLength, 0.4f, fishingBoatWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 木色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.6f, 0.4f, 0.2f));  // 木色
     
     // 桅杆
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 1.5f, 0));
     model = glm::scale(model, glm::vec3(0.05f, 1.0f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CYLINDER, model, glm::vec3(0.6f, 0.4f, 0.2f));
 }
 
-void ObjectRenderer::renderLantern(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLantern(const glm::vec3& position, float rotation) {
     // 灯笼 = 红色圆柱 + 顶部装饰
     float lanternHeight = 1.2f;     // 灯笼高度
     float lanternSize = 0.3f;       // 灯笼大小
@@ -1283,27 +1115,17 @@ void ObjectRenderer::renderLantern(const glm::vec3& position, float rotation, Sh
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(lanternSize, lanternHeight * 0.8f, lanternSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.2f, 0.2f);  // 红色
-    
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addInstance(Primitive::CYLINDER, model, glm::vec3(0.9f, 0.2f, 0.2f));  // 红色
     
     // 顶部装饰
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, lanternHeight * 0.9f, 0));
     model = glm::scale(model, glm::vec3(lanternSize * 1.2f, lanternSize * 0.1f, lanternSize * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.2f);  // 金色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::CUBE, model, glm::vec3(0.8f, 0.8f, 0.2f));  // 金色
 }
 
-void ObjectRenderer::renderStoneLion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderStoneLion(const glm::vec3& position, float rotation) {
     // 石狮子 = 灰色雕像
     float stoneLionSize = 0.8f;     // 石狮子大小
     
@@ -1312,14 +1134,7 @@ void ObjectRenderer::renderStoneLion(const glm::vec3& position, float rotation,
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(stoneLionSize, stoneLionSize, stoneLionSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 灰色
-    
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
-    
-    glBindVertexArray(0);
+    addInstance(Primitive::SPHERE, model, glm::vec3(0.5f, 0.5f, 0.5f));  // 灰色
 }
 
-
 } // namespace WaterTown
@@ -38,7 +38,8 @@ public:
     void clear();
     
     /**
-     * @brief 渲染所有物体
+     * @brief 渲染所有物体：各物体拆成基础几何体实例，每种几何体一次实例化绘制
+     * @param shader 物体着色器（object.vert，实例属性提供模型矩阵与颜色）
      */
     void render(Shader* shader, Camera* camera);
     
@@ -63,6 +64,26 @@ public:
     float longHouseLength = 2.0f;   // Length multiplier for long house
     
 private:
+    /**
+     * @brief 基础几何体种类（实例数组、实例缓冲按此编号）
+     */
+    enum class Primitive {
+        CUBE,
+        CONE,
+        CYLINDER,
+        SPHERE,
+        COUNT
+    };
+    static const int PRIMITIVE_COUNT = static_cast<int>(Primitive::COUNT);
+    
+    /**
+     * @brief 一个部件的实例数据（与 object.vert 的实例属性一一对应）
+     */
+    struct ObjectInstance {
+        glm::vec3 color;
+        glm::mat4 model;
+    };
+    
     std::vector<SceneObject> m_objects;
     
     // 几何体VAO/VBO
@@ -73,6 +94,10 @@ private:
     
     unsigned int m_coneVertexCount, m_cylinderVertexCount, m_sphereVertexCount;
     
+    // 每种几何体本帧的部件实例及其实例缓冲
+    std::vector<ObjectInstance> m_instances[PRIMITIVE_COUNT];
+    GLuint m_instanceVBOs[PRIMITIVE_COUNT];
+    
     /**
      * @brief 生成基础几何体
      */
@@ -82,29 +107,44 @@ private:
     void generateSphere();
     
     /**
-     * @brief 渲染不同类型的物体
+     * @brief 为几何体 VAO 创建实例缓冲并配置实例属性（颜色 location 2，模型矩阵 location 3~6）
+     */
+    void setupInstanceAttributes(Primitive primitive, GLuint vao);
+    
+    /**
+     * @brief 几何体的顶点数
+     */
+    GLsizei getVertexCount(Primitive primitive) const;
+    
+    /**
+     * @brief 追加一个部件实例，render 末尾统一绘制
+     */
+    void addInstance(Primitive primitive, const glm::mat4& model, const glm::vec3& color);
+    
+    /**
+     * @brief 把不同类型的物体拆成部件实例
      */
-    void renderHouse(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle1(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle2(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle3(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle4(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle5(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLongHouse(const glm::vec3& position, float rotation, Shader* shader);
-    void renderBridge(const glm::vec3& position, float rotation, Shader* shader);
-    void renderTree(const glm::vec3& position, float rotation, Shader* shader);
-    void renderWall(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPavilion(const glm::vec3& position, float rotation, Shader* shader);
-    void renderArchBridge(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPaifang(const glm::vec3& position, float rotation, Shader* shader);
-    void renderWaterPavilion(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPier(const glm::vec3& position, float rotation, Shader* shader);
-    void renderTemple(const glm::vec3& position, float rotation, Shader* shader);
-    void renderBamboo(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLotusPond(const glm::vec3& position, float rotation, Shader* shader);
-    void renderFishingBoat(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLantern(const glm::vec3& position, float rotation, Shader* shader);
-    void renderStoneLion(const glm::vec3& position, float rotation, Shader* shader);
+    void renderHouse(const glm::vec3& position, float rotation);
+    void renderHouseStyle1(const glm::vec3& position, float rotation);
+    void renderHouseStyle2(const glm::vec3& position, float rotation);
+    void renderHouseStyle3(const glm::vec3& position, float rotation);
+    void renderHouseStyle4(const glm::vec3& position, float rotation);
+    void renderHouseStyle5(const glm::vec3& position, float rotation);
+    void renderLongHouse(const glm::vec3& position, float rotation);
+    void renderBridge(const glm::vec3& position, float rotation);
+    void renderTree(const glm::vec3& position, float rotation);
+    void renderWall(const glm::vec3& position, float rotation);
+    void renderPavilion(const glm::vec3& position, float rotation);
+    void renderArchBridge(const glm::vec3& position, float rotation);
+    void renderPaifang(const glm::vec3& position, float rotation);
+    void renderWaterPavilion(const glm::vec3& position, float rotation);
+    void renderPier(const glm::vec3& position, float rotation);
+    void renderTemple(const glm::vec3& position, float rotation);
+    void renderBamboo(const glm::vec3& position, float rotation);
+    void renderLotusPond(const glm::vec3& position, float rotation);
+    void renderFishingBoat(const glm::vec3& position, float rotation);
+    void renderLantern(const glm::vec3& position, float rotation);
+    void renderStoneLion(const glm::vec3& position, float rotation);
 };
 
 } // namespace WaterTown
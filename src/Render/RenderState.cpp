@@ -0,0 +1,150 @@
+#include "RenderState.h"
+
+namespace WaterTown {
+
+namespace {
+
+// 跟踪的开关（其余 cap 直接转发）
+const GLenum TRACKED_CAPS[] = {GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_STENCIL_TEST, GL_SCISSOR_TEST};
+const int TRACKED_CAP_COUNT = sizeof(TRACKED_CAPS) / sizeof(TRACKED_CAPS[0]);
+
+// 未知状态用一个不可能的名字表示
+const GLuint UNKNOWN = 0xFFFFFFFFu;
+const GLenum UNKNOWN_ENUM = 0xFFFFFFFFu;
+
+struct State {
+    GLuint program = UNKNOWN;
+    GLuint vertexArray = UNKNOWN;
+    GLuint arrayBuffer = UNKNOWN;
+    GLuint elementBuffer = UNKNOWN;   // 属于当前 VAO 的状态，切换 VAO 时失效
+    int caps[TRACKED_CAP_COUNT];      // -1 未知，0 关，1 开
+    GLenum blendSrc = UNKNOWN_ENUM;
+    GLenum blendDst = UNKNOWN_ENUM;
+    
+    State() {
+        for (int i = 0; i < TRACKED_CAP_COUNT; ++i) caps[i] = -1;
+    }
+};
+
+State g_state;
+RenderState::Stats g_frameStats;
+RenderState::Stats g_lastFrameStats;
+
+int capIndex(GLenum cap) {
+    for (int i = 0; i < TRACKED_CAP_COUNT; ++i) {
+        if (TRACKED_CAPS[i] == cap) return i;
+    }
+    return -1;
+}
+
+// 值已是目标值时返回 false（计为跳过），否则更新缓存并返回 true（计为发出）
+template <typename T>
+bool change(T& cached, T value) {
+    if (cached == value) {
+        ++g_frameStats.skipped;
+        return false;
+    }
+    cached = value;
+    ++g_frameStats.issued;
+    return true;
+}
+
+void setCap(GLenum cap, bool enabled) {
+    int index = capIndex(cap);
+    if (index >= 0 && !change(g_state.caps[index], enabled ? 1 : 0)) return;
+    if (index < 0) ++g_frameStats.issued;
+    if (enabled) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+}
+
+} // namespace
+
+void RenderState::useProgram(GLuint program) {
+    if (change(g_state.program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void RenderState::bindVertexArray(GLuint vao) {
+    if (change(g_state.vertexArray, vao)) {
+        glBindVertexArray(vao);
+        g_state.elementBuffer = UNKNOWN;
+    }
+}
+
+void RenderState::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint* cached = nullptr;
+    if (target == GL_ARRAY_BUFFER) {
+        cached = &g_state.arrayBuffer;
+    } else if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        cached = &g_state.elementBuffer;
+    }
+    
+    if (!cached) {
+        ++g_frameStats.issued;
+        glBindBuffer(target, buffer);
+    } else if (change(*cached, buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void RenderState::enable(GLenum cap) {
+    setCap(cap, true);
+}
+
+void RenderState::disable(GLenum cap) {
+    setCap(cap, false);
+}
+
+void RenderState::setBlendFunc(GLenum sfactor, GLenum dfactor) {
+    if (g_state.blendSrc == sfactor && g_state.blendDst == dfactor) {
+        ++g_frameStats.skipped;
+        return;
+    }
+    g_state.blendSrc = sfactor;
+    g_state.blendDst = dfactor;
+    ++g_frameStats.issued;
+    glBlendFunc(sfactor, dfactor);
+}
+
+void RenderState::deleteProgram(GLuint program) {
+    if (g_state.program == program) g_state.program = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void RenderState::deleteVertexArrays(GLsizei count, const GLuint* vaos) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (g_state.vertexArray == vaos[i]) {
+            g_state.vertexArray = UNKNOWN;
+            g_state.elementBuffer = UNKNOWN;
+        }
+    }
+    glDeleteVertexArrays(count, vaos);
+}
+
+void RenderState::deleteBuffers(GLsizei count, const GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (g_state.arrayBuffer == buffers[i]) g_state.arrayBuffer = UNKNOWN;
+        if (g_state.elementBuffer == buffers[i]) g_state.elementBuffer = UNKNOWN;
+    }
+    glDeleteBuffers(count, buffers);
+}
+
+void RenderState::invalidate() {
+    g_state = State();
+}
+
+void RenderState::beginFrame() {
+    g_lastFrameStats = g_frameStats;
+    g_frameStats = Stats();
+    invalidate();
+}
+
+const RenderState::Stats& RenderState::getLastFrameStats() {
+    return g_lastFrameStats;
+}
+
+} // namespace WaterTown
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace WaterTown {
+
+/**
+ * @brief OpenGL 绑定/开关状态跟踪，过滤与当前状态相同的重复调用
+ *
+ * 覆盖 glUseProgram、glBindVertexArray、glBindBuffer（GL_ARRAY_BUFFER / GL_ELEMENT_ARRAY_BUFFER，
+ * 其余目标直接转发）、glEnable/glDisable、glBlendFunc。程序中这些调用都应经过这里，
+ * 删除对象也要用这里的 delete*，否则缓存会与实际状态不一致；外部代码（如 ImGui）改动状态后调用 invalidate。
+ * 只能在持有 GL 上下文的主线程使用。
+ */
+class RenderState {
+public:
+    /**
+     * @brief 调用计数
+     */
+    struct Stats {
+        int issued = 0;   // 实际发出的 GL 调用
+        int skipped = 0;  // 与当前状态相同而跳过的调用
+    };
+    
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void enable(GLenum cap);
+    static void disable(GLenum cap);
+    static void setBlendFunc(GLenum sfactor, GLenum dfactor);
+    
+    /**
+     * @brief 删除对象，并清除缓存中对它们的绑定（GL 删除已绑定对象时会隐式解绑，名字之后可能被复用）
+     */
+    static void deleteProgram(GLuint program);
+    static void deleteVertexArrays(GLsizei count, const GLuint* vaos);
+    static void deleteBuffers(GLsizei count, const GLuint* buffers);
+    
+    /**
+     * @brief 忘记所有缓存的状态，之后的每个调用都会发出一次
+     */
+    static void invalidate();
+    
+    /**
+     * @brief 每帧开始时调用：保存上一帧计数并清零，同时 invalidate
+     */
+    static void beginFrame();
+    
+    /**
+     * @brief 上一帧的调用计数
+     */
+    static const Stats& getLastFrameStats();
+};
+
+} // namespace WaterTown
@@ -1,75 +1,322 @@
 #include "Shader.h"
+#include "FrameUniforms.h"
+#include "RenderState.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
 #include <glm/gtc/type_ptr.hpp>
 
 namespace WaterTown {
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+const char* const Shader::BINARY_CACHE_DIR = "shader_cache";
+
+namespace {
+
+// 缓存文件头
+const char BINARY_MAGIC[4] = {'W', 'T', 'P', 'B'};
+const uint32_t BINARY_VERSION = 1;
+
+struct BinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;          // 源码 + 驱动字符串的哈希
+    uint32_t format;       // glGetProgramBinary 返回的格式
+    uint32_t length;       // 二进制长度（字节）
+    float compileMs;       // 写入时源码编译 + 链接的耗时
+    uint32_t padding;
+};
+
+// 64 位 FNV-1a，可分段累加
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashString(const char* str, uint64_t hash = 14695981039346656037ull) {
+    // 各段之间加分隔符，避免拼接歧义
+    hash = str ? hashBytes(str, std::strlen(str), hash) : hash;
+    return hashBytes("\0", 1, hash);
+}
+
+// 只依赖核心版本标志：vcpkg 的 glad 默认不生成扩展标志
+bool isProgramBinarySupported() {
+    if (!GLAD_GL_VERSION_4_1) return false;
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+// 缓存文件名：着色器文件名（去掉目录）拼接
+std::string binaryCachePath(const char* vertexPath, const char* fragmentPath) {
+    auto baseName = [](const std::string& path) {
+        size_t slash = path.find_last_of("/\\");
+        return (slash == std::string::npos) ? path : path.substr(slash + 1);
+    };
+    return std::string(Shader::BINARY_CACHE_DIR) + "/" + baseName(vertexPath) + "+" + baseName(fragmentPath) + ".bin";
+}
+
+void makeDirectory(const char* path) {
+#ifdef _WIN32
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
+float millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath) : m_programID(0) {
     // 1. 从文件加载着色器源代码
     std::string vertexCode = loadShaderSource(vertexPath);
     std::string fragmentCode = loadShaderSource(fragmentPath);
     
+    // 2. 源码与驱动都未改变时直接载入缓存的程序二进制
+    bool binarySupported = isProgramBinarySupported();
+    std::string cachePath = binaryCachePath(vertexPath, fragmentPath);
+    uint64_t key = 0;
+    if (binarySupported) {
+        key = hashString(vertexCode.c_str());
+        key = hashString(fragmentCode.c_str(), key);
+        key = hashString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)), key);
+        key = hashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), key);
+        key = hashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), key);
+        
+        auto start = std::chrono::steady_clock::now();
+        float compileMs = 0.0f;
+        if (loadProgramBinary(cachePath, key, compileMs)) {
+            cacheUniformLocations();
+            bindFrameUniforms();
+            float loadMs = millisecondsSince(start);
+            std::cout << "Shader program loaded from binary cache (ID: " << m_programID << ", "
+                      << loadMs << " ms, saved " << std::max(compileMs - loadMs, 0.0f) << " ms)" << std::endl;
+            return;
+        }
+    }
+    
+    // 3. 编译、链接，成功后写入缓存
+    auto start = std::chrono::steady_clock::now();
+    bool linked = buildFromSource(vertexCode, fragmentCode, binarySupported);
+    float compileMs = millisecondsSince(start);
+    cacheUniformLocations();
+    bindFrameUniforms();
+    if (linked && binarySupported) {
+        saveProgramBinary(cachePath, key, compileMs);
+    }
+    
+    std::cout << "Shader program created successfully (ID: " << m_programID << ", "
+              << compileMs << " ms)" << std::endl;
+}
+
+bool Shader::buildFromSource(const std::string& vertexCode, const std::string& fragmentCode, bool retrievable) {
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
     
-    // 2. 编译着色器
+    // 编译着色器
     unsigned int vertex = compileShader(vShaderCode, GL_VERTEX_SHADER);
     unsigned int fragment = compileShader(fShaderCode, GL_FRAGMENT_SHADER);
     
-    // 3. 链接着色器程序
+    // 链接着色器程序
     m_programID = glCreateProgram();
+    if (retrievable) {
+        glProgramParameteri(m_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(m_programID, vertex);
     glAttachShader(m_programID, fragment);
     glLinkProgram(m_programID);
-    checkCompileErrors(m_programID, "PROGRAM");
+    bool linked = checkCompileErrors(m_programID, "PROGRAM");
     
-    // 4. 删除着色器对象（已经链接到程序中，不再需要）
+    // 删除着色器对象（已经链接到程序中，不再需要）
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    return linked;
+}
+
+bool Shader::loadProgramBinary(const std::string& cachePath, uint64_t key, float& outCompileMs) {
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file) return false;
+    
+    BinaryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 ||
+        header.version != BINARY_VERSION || header.key != key || header.length == 0) {
+        std::cout << "Shader binary cache out of date: " << cachePath << std::endl;
+        return false;
+    }
     
-    std::cout << "Shader program created successfully (ID: " << m_programID << ")" << std::endl;
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size())) return false;
+    
+    // 驱动更新等原因仍可能被拒绝，此时回退到源码编译
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        RenderState::deleteProgram(program);
+        std::cout << "Shader binary rejected by driver, recompiling: " << cachePath << std::endl;
+        return false;
+    }
+    
+    m_programID = program;
+    outCompileMs = header.compileMs;
+    return true;
+}
+
+void Shader::saveProgramBinary(const std::string& cachePath, uint64_t key, float compileMs) const {
+    GLint length = 0;
+    glGetProgramiv(m_programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(m_programID, length, &length, &format, binary.data());
+    
+    makeDirectory(BINARY_CACHE_DIR);
+    std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "WARNING::SHADER::BINARY_CACHE_NOT_WRITABLE: " << cachePath << std::endl;
+        return;
+    }
+    
+    BinaryHeader header;
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = static_cast<uint32_t>(length);
+    header.compileMs = compileMs;
+    header.padding = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), length);
 }
 
 Shader::~Shader() {
-    glDeleteProgram(m_programID);
+    RenderState::deleteProgram(m_programID);
 }
 
 void Shader::use() const {
-    glUseProgram(m_programID);
+    RenderState::useProgram(m_programID);
 }
 
-void Shader::setBool(const std::string& name, bool value) const {
-    glUniform1i(glGetUniformLocation(m_programID, name.c_str()), static_cast<int>(value));
+GLint Shader::getUniformLocation(UniformName name) const {
+    auto it = m_uniformLocations.find(name.hash);
+    if (it != m_uniformLocations.end()) {
+        if (it->second.name == name.name) {
+            return it->second.location;
+        }
+        
+        // 哈希冲突：按完整名字另行缓存
+        auto colliding = m_collidingLocations.find(name.name);
+        if (colliding != m_collidingLocations.end()) {
+            return colliding->second;
+        }
+        GLint location = glGetUniformLocation(m_programID, name.name);
+        m_collidingLocations.emplace(name.name, location);
+        return location;
+    }
+    
+    // 链接时未枚举到（未使用的 uniform 等），查一次后缓存结果
+    GLint location = glGetUniformLocation(m_programID, name.name);
+    m_uniformLocations.emplace(name.hash, UniformEntry{name.name, location});
+    return location;
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+void Shader::cacheUniformLocations() {
+    m_uniformLocations.clear();
+    m_collidingLocations.clear();
+    
+    GLint uniformCount = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string buffer(std::max(maxLength, 1), '\0');
+    
+    auto addLocation = [&](const std::string& name) {
+        GLint location = glGetUniformLocation(m_programID, name.c_str());
+        if (location < 0) return; // uniform 块中的成员没有位置
+        
+        auto result = m_uniformLocations.insert({hashName(name.c_str()), UniformEntry{name, location}});
+        if (!result.second && result.first->second.name != name) {
+            m_collidingLocations.emplace(name, location);
+        }
+    };
+    
+    static const std::string arraySuffix = "[0]";
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_programID, static_cast<GLuint>(i), maxLength, &length, &size, &type, &buffer[0]);
+        std::string name(buffer.data(), length);
+        
+        // 普通数组报告为 "name[0]"：不带下标的名字与每个元素都登记；
+        // 结构体数组成员（"name[0].field"）每个元素单独报告，原样登记
+        bool isArray = name.size() > arraySuffix.size() &&
+                       name.compare(name.size() - arraySuffix.size(), arraySuffix.size(), arraySuffix) == 0;
+        if (isArray) {
+            std::string base = name.substr(0, name.size() - arraySuffix.size());
+            addLocation(base);
+            for (GLint element = 0; element < size; ++element) {
+                addLocation(base + "[" + std::to_string(element) + "]");
+            }
+        } else {
+            addLocation(name);
+        }
+    }
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
+void Shader::bindFrameUniforms() {
+    GLuint blockIndex = glGetUniformBlockIndex(m_programID, "FrameUniforms");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_programID, blockIndex, FrameUniforms::BINDING);
+    }
 }
 
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+void Shader::setBool(GLint location, bool value) const {
+    glUniform1i(location, static_cast<int>(value));
 }
 
-void Shader::setVec3(const std::string& name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(m_programID, name.c_str()), x, y, z);
+void Shader::setInt(GLint location, int value) const {
+    glUniform1i(location, value);
 }
 
-void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
-    glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+void Shader::setFloat(GLint location, float value) const {
+    glUniform1f(location, value);
 }
 
-void Shader::setVec2(const std::string& name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(m_programID, name.c_str()), x, y);
+void Shader::setVec3(GLint location, const glm::vec3& value) const {
+    glUniform3fv(location, 1, glm::value_ptr(value));
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& value) const {
-    glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+void Shader::setVec3(GLint location, float x, float y, float z) const {
+    glUniform3f(location, x, y, z);
+}
+
+void Shader::setVec2(GLint location, const glm::vec2& value) const {
+    glUniform2fv(location, 1, glm::value_ptr(value));
+}
+
+void Shader::setVec2(GLint location, float x, float y) const {
+    glUniform2f(location, x, y);
+}
+
+void Shader::setMat4(GLint location, const glm::mat4& value) const {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 std::string Shader::loadShaderSource(const char* path) {
@@ -80,19 +327,19 @@ std::string Shader::loadShaderSource(const char* path) {
     shaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
     
     try {
-        // 打开文件
-        shaderFile.open(path);
-        std::stringstream shaderStream;
+        // 打开文件，按文件大小一次读入
+        shaderFile.open(path, std::ios::binary | std::ios::ate);
+        std::streamsize size = shaderFile.tellg();
+        shaderFile.seekg(0, std::ios::beg);
         
-        // 读取文件缓冲到数据流中
-        shaderStream << shaderFile.rdbuf();
+        code.resize(static_cast<size_t>(size));
+        if (size > 0) {
+            shaderFile.read(&code[0], size);
+        }
         
         // 关闭文件
         shaderFile.close();
         
-        // 转换数据流到字符串
-        code = shaderStream.str();
-        
         std::cout << "Loaded shader: " << path << std::endl;
     }
     catch (std::ifstream::failure& e) {
@@ -115,7 +362,7 @@ unsigned int Shader::compileShader(const char* source, GLenum type) {
     return shader;
 }
 
-void Shader::checkCompileErrors(unsigned int shader, const std::string& type) {
+bool Shader::checkCompileErrors(unsigned int shader, const std::string& type) {
     int success;
     char infoLog[1024];
     
@@ -136,6 +383,7 @@ void Shader::checkCompileErrors(unsigned int shader, const std::string& type) {
             std::cerr << "========================================" << std::endl;
         }
     }
+    return success != 0;
 }
 
 } // namespace WaterTown
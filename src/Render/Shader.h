@@ -2,15 +2,45 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace WaterTown {
 
 /**
  * @brief 着色器管理类，支持从文件加载、编译、链接着色器程序
+ *
+ * 驱动支持程序二进制（GL 4.1 且至少一种二进制格式）时，链接结果缓存在 BINARY_CACHE_DIR 下，
+ * 源码与驱动（厂商/渲染器/版本字符串）都未改变时直接载入二进制，跳过编译和链接。
  */
 class Shader {
 public:
+    /**
+     * @brief uniform 名字的 32 位 FNV-1a 哈希（constexpr，常量上下文中在编译期求值）
+     */
+    static constexpr uint32_t hashName(const char* str) {
+        uint32_t hash = 2166136261u;
+        while (*str) {
+            hash = (hash ^ static_cast<unsigned char>(*str++)) * 16777619u;
+        }
+        return hash;
+    }
+    
+    /**
+     * @brief uniform 名字及其哈希，查位置时不再构造 std::string
+     *
+     * 设置方法中由字符串字面量隐式构造时哈希在运行期计算；热路径上可声明常量让哈希在编译期算好：
+     * static constexpr Shader::UniformName kModel("uModel");
+     */
+    struct UniformName {
+        const char* name;
+        uint32_t hash;
+        
+        constexpr UniformName(const char* str) : name(str), hash(hashName(str)) {}
+        UniformName(const std::string& str) : name(str.c_str()), hash(hashName(str.c_str())) {}
+    };
+    
     /**
      * @brief 构造函数，加载并编译着色器
      * @param vertexPath 顶点着色器文件路径
@@ -18,6 +48,11 @@ public:
      */
     Shader(const char* vertexPath, const char* fragmentPath);
     
+    /**
+     * @brief 程序二进制缓存目录（相对工作目录）
+     */
+    static const char* const BINARY_CACHE_DIR;
+    
     /**
      * @brief 析构函数，删除着色器程序
      */
@@ -38,19 +73,75 @@ public:
      */
     unsigned int getID() const { return m_programID; }
     
-    // Uniform 设置方法
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec2(const std::string& name, float x, float y) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
-    void setMat4(const std::string& name, const glm::mat4& value) const;
+    /**
+     * @brief 查询 uniform 位置（链接时已缓存全部活动 uniform，未缓存的名字查一次后也记下）
+     * @return 位置，不存在或未被使用时为 -1（传给设置方法时被忽略）
+     */
+    GLint getUniformLocation(UniformName name) const;
+    
+    // Uniform 设置方法（按名字）
+    void setBool(UniformName name, bool value) const { setBool(getUniformLocation(name), value); }
+    void setInt(UniformName name, int value) const { setInt(getUniformLocation(name), value); }
+    void setFloat(UniformName name, float value) const { setFloat(getUniformLocation(name), value); }
+    void setVec2(UniformName name, const glm::vec2& value) const { setVec2(getUniformLocation(name), value); }
+    void setVec2(UniformName name, float x, float y) const { setVec2(getUniformLocation(name), x, y); }
+    void setVec3(UniformName name, const glm::vec3& value) const { setVec3(getUniformLocation(name), value); }
+    void setVec3(UniformName name, float x, float y, float z) const { setVec3(getUniformLocation(name), x, y, z); }
+    void setMat4(UniformName name, const glm::mat4& value) const { setMat4(getUniformLocation(name), value); }
+    
+    // Uniform 设置方法（按 getUniformLocation 预先取得的位置，逐物体绘制时使用）
+    void setBool(GLint location, bool value) const;
+    void setInt(GLint location, int value) const;
+    void setFloat(GLint location, float value) const;
+    void setVec2(GLint location, const glm::vec2& value) const;
+    void setVec2(GLint location, float x, float y) const;
+    void setVec3(GLint location, const glm::vec3& value) const;
+    void setVec3(GLint location, float x, float y, float z) const;
+    void setMat4(GLint location, const glm::mat4& value) const;
 
 private:
     unsigned int m_programID;
     
+    struct UniformEntry {
+        std::string name;
+        GLint location;
+    };
+    
+    // 名字哈希 -> 名字与 uniform 位置（命中时比对名字）
+    mutable std::unordered_map<uint32_t, UniformEntry> m_uniformLocations;
+    
+    // 与已缓存名字哈希冲突的名字 -> uniform 位置
+    mutable std::unordered_map<std::string, GLint> m_collidingLocations;
+    
+    /**
+     * @brief 链接后枚举所有活动 uniform（数组展开到每个元素），填充位置表
+     */
+    void cacheUniformLocations();
+    
+    /**
+     * @brief 把 FrameUniforms uniform 块（若有）绑定到 FrameUniforms::BINDING
+     */
+    void bindFrameUniforms();
+    
+    /**
+     * @brief 从源码编译并链接，结果写入 m_programID
+     * @return 链接是否成功
+     */
+    bool buildFromSource(const std::string& vertexCode, const std::string& fragmentCode, bool retrievable);
+    
+    /**
+     * @brief 从缓存文件载入程序二进制（缓存键不符、驱动拒绝时返回 false，m_programID 保持为 0）
+     * @param cachePath 缓存文件路径
+     * @param key 源码与驱动字符串的哈希
+     * @param outCompileMs 输出写入缓存时记录的源码编译耗时（毫秒）
+     */
+    bool loadProgramBinary(const std::string& cachePath, uint64_t key, float& outCompileMs);
+    
+    /**
+     * @brief 把已链接程序的二进制写入缓存文件
+     */
+    void saveProgramBinary(const std::string& cachePath, uint64_t key, float compileMs) const;
+    
     /**
      * @brief 从文件加载着色器源代码
      * @param path 文件路径
@@ -70,8 +161,9 @@ private:
      * @brief 检查编译/链接错误
      * @param shader 着色器或程序 ID
      * @param type 类型（"VERTEX", "FRAGMENT", "PROGRAM"）
+     * @return 是否成功
      */
-    void checkCompileErrors(unsigned int shader, const std::string& type);
+    bool checkCompileErrors(unsigned int shader, const std::string& type);
 };
 
 } // namespace WaterTown
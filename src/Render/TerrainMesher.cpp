@@ -0,0 +1,315 @@
+#include "TerrainMesher.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace WaterTown {
+
+TerrainMesher::TerrainMesher(int gridSize)
+    : m_gridSize(gridSize), m_greedyMeshing(true) {
+}
+
+int TerrainMesher::getChunksPerSide() const {
+    const int chunkSize = SceneEditor::TERRAIN_CHUNK_SIZE;
+    return (m_gridSize + chunkSize - 1) / chunkSize;
+}
+
+glm::vec3 TerrainMesher::getTerrainColor(TerrainType type) {
+    switch (type) {
+        case TerrainType::GRASS:
+            return glm::vec3(0.3f, 0.7f, 0.3f);
+        case TerrainType::WATER:
+            return glm::vec3(0.2f, 0.4f, 0.9f);
+        case TerrainType::STONE:
+            return glm::vec3(0.7f, 0.7f, 0.7f);
+        case TerrainType::EMPTY:
+            return glm::vec3(0.0f); // 透明/不可见
+        default:
+            return glm::vec3(1.0f, 1.0f, 1.0f);
+    }
+}
+
+float TerrainMesher::getTerrainHeight(TerrainType type) {
+    switch (type) {
+        case TerrainType::GRASS:
+            return 1.0f;
+        case TerrainType::STONE:
+            return 1.1f;
+        case TerrainType::WATER:
+            return SceneEditor::WATER_LEVEL;
+        default:
+            return 0.3f;
+    }
+}
+
+glm::vec3 TerrainMesher::getChunkOrigin(int chunkX, int chunkZ) const {
+    const int chunkSize = SceneEditor::TERRAIN_CHUNK_SIZE;
+    return glm::vec3((chunkX * chunkSize - m_gridSize / 2.0f) * SceneEditor::CELL_SIZE,
+                     0.0f,
+                     (chunkZ * chunkSize - m_gridSize / 2.0f) * SceneEditor::CELL_SIZE);
+}
+
+void TerrainMesher::buildTerrainVertices(const TerrainMap& map, int chunkX, int chunkZ,
+                                         std::vector<TerrainVertex>& outVertices,
+                                         std::vector<BrickInstance>& outBricks) const {
+    const float cellSize = SceneEditor::CELL_SIZE;
+    const float expand = cellSize * 0.05f; // slight overlap to avoid cracks on the plane
+    const float waterSurface = getTerrainHeight(TerrainType::WATER);
+    const float wallBase = waterSurface - 0.1f; // sink a bit into the river to avoid gaps
+    const float brickScale = 4.0f;
+    const float wallThickness = cellSize * 0.45f * brickScale;
+    const float verticalGap = 0.01f * brickScale;
+    const float horizontalGap = cellSize * 0.04f * brickScale;
+    const float baseBrickHeight = cellSize * 0.15f;
+    const float baseBrickLength = cellSize * 0.25f;
+    const float scaledBrickHeight = baseBrickHeight * brickScale;
+    const float scaledBrickLength = baseBrickLength * brickScale;
+
+    const int chunkSize = SceneEditor::TERRAIN_CHUNK_SIZE;
+    const int startX = chunkX * chunkSize;
+    const int startZ = chunkZ * chunkSize;
+    const int endX = std::min(startX + chunkSize, m_gridSize);
+    const int endZ = std::min(startZ + chunkSize, m_gridSize);
+
+    const glm::vec3 chunkOrigin = getChunkOrigin(chunkX, chunkZ);
+
+    outVertices.clear();
+    outVertices.reserve(chunkSize * chunkSize * 6);
+    outBricks.clear();
+
+    auto addWallBricks = [&](float minX, float maxX, float minZ, float maxZ, float topHeight, bool alongZ) {
+        float usableHeight = topHeight - wallBase;
+        if (usableHeight <= 0.05f) {
+            return;
+        }
+
+        float runLength = alongZ ? (maxZ - minZ) : (maxX - minX);
+        if (runLength <= 0.05f) {
+            return;
+        }
+
+        float gapY = std::min(verticalGap, usableHeight * 0.25f);
+        float gapRun = std::min(horizontalGap, runLength * 0.5f);
+        float brickHeight = std::min(scaledBrickHeight, usableHeight);
+        float brickLength = std::min(scaledBrickLength, runLength);
+
+        if (brickHeight <= 0.0f || brickLength <= 0.0f) {
+            return;
+        }
+
+        int layerIndex = 0;
+        for (float y0 = wallBase; y0 < topHeight - 0.001f; y0 += brickHeight + gapY, ++layerIndex) {
+            float y1 = std::min(y0 + brickHeight, topHeight);
+
+            int segmentIndex = 0;
+            for (float offset = 0.0f; offset < runLength - 0.001f; offset += brickLength + gapRun, ++segmentIndex) {
+                float segStart = (alongZ ? minZ : minX) + offset;
+                float segEnd = std::min(segStart + brickLength, alongZ ? maxZ : maxX);
+                if (segEnd <= segStart + 0.0005f) {
+                    break;
+                }
+
+                glm::vec3 minCorner;
+                glm::vec3 maxCorner;
+                if (alongZ) {
+                    minCorner = glm::vec3(minX, y0, segStart);
+                    maxCorner = glm::vec3(maxX, y1, segEnd);
+                } else {
+                    minCorner = glm::vec3(segStart, y0, minZ);
+                    maxCorner = glm::vec3(segEnd, y1, maxZ);
+                }
+
+                unsigned int colorIndex = static_cast<unsigned int>((layerIndex + segmentIndex) % 2);
+                outBricks.push_back({minCorner, maxCorner - minCorner, colorIndex});
+
+                if (segEnd >= (alongZ ? maxZ : maxX) - 0.001f) {
+                    break;
+                }
+            }
+        }
+    };
+
+    auto packVertex = [&](float x, float y, float z, int normalIndex, int terrainType) {
+        TerrainVertex v;
+        v.position[0] = static_cast<int16_t>(std::lround((x - chunkOrigin.x) * POSITION_QUANT));
+        v.position[1] = static_cast<int16_t>(std::lround((y - chunkOrigin.y) * POSITION_QUANT));
+        v.position[2] = static_cast<int16_t>(std::lround((z - chunkOrigin.z) * POSITION_QUANT));
+        v.normalIndex = static_cast<uint8_t>(normalIndex);
+        v.terrainType = static_cast<uint8_t>(terrainType);
+        return v;
+    };
+
+    // 顶面四边形：相邻两侧各外扩 expand/2，避免接缝
+    auto addTopQuad = [&](float tileX0, float tileX1, float tileZ0, float tileZ1,
+                          float height, int terrainType) {
+        float x0 = tileX0 - expand * 0.5f;
+        float x1 = tileX1 + expand * 0.5f;
+        float z0 = tileZ0 - expand * 0.5f;
+        float z1 = tileZ1 + expand * 0.5f;
+
+        TerrainVertex v0 = packVertex(x0, height, z0, 0, terrainType);
+        TerrainVertex v1 = packVertex(x1, height, z0, 0, terrainType);
+        TerrainVertex v2 = packVertex(x1, height, z1, 0, terrainType);
+        TerrainVertex v3 = packVertex(x0, height, z1, 0, terrainType);
+
+        outVertices.push_back(v0);
+        outVertices.push_back(v1);
+        outVertices.push_back(v2);
+        outVertices.push_back(v0);
+        outVertices.push_back(v2);
+        outVertices.push_back(v3);
+    };
+
+    if (m_greedyMeshing) {
+        // 贪心合并：同类型（即同高度、同颜色）的格子合并为尽量大的矩形。
+        // 着色器按世界坐标取纹理，合并后插值结果与逐格一致。
+        const int width = endX - startX;
+        const int depth = endZ - startZ;
+        std::vector<int> cellTypes(width * depth);
+        for (int z = 0; z < depth; ++z) {
+            for (int x = 0; x < width; ++x) {
+                TerrainType type = map.get(startX + x, startZ + z);
+                bool hasTop = (type != TerrainType::WATER && type != TerrainType::EMPTY);
+                cellTypes[z * width + x] = hasTop ? static_cast<int>(type) : -1;
+            }
+        }
+
+        for (int z = 0; z < depth; ++z) {
+            for (int x = 0; x < width; ) {
+                int typeInt = cellTypes[z * width + x];
+                if (typeInt < 0) {
+                    ++x;
+                    continue;
+                }
+
+                // 先沿 X 延伸
+                int runWidth = 1;
+                while (x + runWidth < width && cellTypes[z * width + x + runWidth] == typeInt) {
+                    ++runWidth;
+                }
+
+                // 再沿 Z 延伸，要求整行都匹配
+                int runDepth = 1;
+                while (z + runDepth < depth) {
+                    const int* row = &cellTypes[(z + runDepth) * width + x];
+                    bool rowMatches = true;
+                    for (int i = 0; i < runWidth; ++i) {
+                        if (row[i] != typeInt) {
+                            rowMatches = false;
+                            break;
+                        }
+                    }
+                    if (!rowMatches) break;
+                    ++runDepth;
+                }
+
+                // 标记已合并的格子
+                for (int dz = 0; dz < runDepth; ++dz) {
+                    for (int i = 0; i < runWidth; ++i) {
+                        cellTypes[(z + dz) * width + x + i] = -1;
+                    }
+                }
+
+                TerrainType type = static_cast<TerrainType>(typeInt);
+                float tileX0 = (startX + x - m_gridSize / 2.0f) * cellSize;
+                float tileZ0 = (startZ + z - m_gridSize / 2.0f) * cellSize;
+                addTopQuad(tileX0, tileX0 + runWidth * cellSize, tileZ0, tileZ0 + runDepth * cellSize,
+                           getTerrainHeight(type), typeInt);
+                x += runWidth;
+            }
+        }
+    }
+
+    // 逐行用位平面做整字邻居判断：陆地 & (水平移一位) 即为需要砌墙的格子
+    const int wordsPerRow = map.getWordsPerRow();
+    std::vector<uint64_t> rowMask(wordsPerRow);
+
+    // 遍历 mask 中落在 [startX, endX) 的置位
+    auto forEachCell = [&](const uint64_t* mask, int z, const std::function<void(int, int)>& fn) {
+        for (int w = startX >> 6; w <= (endX - 1) >> 6; ++w) {
+            uint64_t bits = mask[w];
+            int wordStart = w * 64;
+            if (startX > wordStart) {
+                bits &= ~uint64_t(0) << (startX - wordStart);
+            }
+            if (endX < wordStart + 64) {
+                bits &= (uint64_t(1) << (endX - wordStart)) - 1;
+            }
+            while (bits) {
+                int x = wordStart + TerrainMap::lowestBit(bits);
+                bits &= bits - 1;
+                fn(x, z);
+            }
+        }
+    };
+
+    auto tileOrigin = [&](int x, int z) {
+        return glm::vec2((x - m_gridSize / 2.0f) * cellSize, (z - m_gridSize / 2.0f) * cellSize);
+    };
+
+    for (int z = startZ; z < endZ; ++z) {
+        // 水面由 WaterSurface 渲染，空地不渲染，只有草地/石路有顶面
+        if (!m_greedyMeshing) {
+            map.computeLandRow(z, rowMask.data());
+            forEachCell(rowMask.data(), z, [&](int x, int cellZ) {
+                TerrainType type = map.get(x, cellZ);
+                glm::vec2 tile = tileOrigin(x, cellZ);
+                addTopQuad(tile.x, tile.x + cellSize, tile.y, tile.y + cellSize,
+                           getTerrainHeight(type), static_cast<int>(type));
+            });
+        }
+
+        // 河岸只在陆地和水之间生成（越界按空地处理，不生成墙）
+        for (int dir = 0; dir < TerrainMap::DIRECTION_COUNT; ++dir) {
+            map.computeBankEdges(z, static_cast<TerrainMap::Direction>(dir), rowMask.data());
+            forEachCell(rowMask.data(), z, [&](int x, int cellZ) {
+                float height = getTerrainHeight(map.get(x, cellZ));
+                glm::vec2 tile = tileOrigin(x, cellZ);
+                float tileX0 = tile.x;
+                float tileZ0 = tile.y;
+                float tileX1 = tileX0 + cellSize;
+                float tileZ1 = tileZ0 + cellSize;
+
+                if (dir == TerrainMap::POS_X || dir == TerrainMap::NEG_X) {
+                    bool positive = (dir == TerrainMap::POS_X);
+                    float boundaryX = positive ? tileX1 : tileX0;
+                    float minX = positive ? boundaryX : boundaryX - wallThickness;
+                    float maxX = positive ? boundaryX + wallThickness : boundaryX;
+                    addWallBricks(minX, maxX, tileZ0, tileZ1, height, true);
+                } else {
+                    bool positive = (dir == TerrainMap::POS_Z);
+                    float boundaryZ = positive ? tileZ1 : tileZ0;
+                    float minZ = positive ? boundaryZ : boundaryZ - wallThickness;
+                    float maxZ = positive ? boundaryZ + wallThickness : boundaryZ;
+                    addWallBricks(tileX0, tileX1, minZ, maxZ, height, false);
+                }
+            });
+        }
+    }
+}
+
+void TerrainMesher::meshChunk(const TerrainMap& map, int chunkX, int chunkZ, ChunkMesh& outMesh) const {
+    std::vector<TerrainVertex> vertices;
+    buildTerrainVertices(map, chunkX, chunkZ, vertices, outMesh.bricks);
+
+    // 按地形类型计数排序，一次上传后各类型占据连续的 (first, count) 区间
+    int32_t typeCounts[TERRAIN_TYPE_COUNT] = {0};
+    for (const auto& v : vertices) {
+        ++typeCounts[v.terrainType];
+    }
+    int32_t typeOffsets[TERRAIN_TYPE_COUNT];
+    int32_t first = 0;
+    for (int type = 0; type < TERRAIN_TYPE_COUNT; ++type) {
+        outMesh.typeFirst[type] = first;
+        outMesh.typeVertexCount[type] = typeCounts[type];
+        typeOffsets[type] = first;
+        first += typeCounts[type];
+    }
+
+    outMesh.vertices.resize(vertices.size());
+    for (const auto& v : vertices) {
+        outMesh.vertices[typeOffsets[v.terrainType]++] = v;
+    }
+}
+
+} // namespace WaterTown
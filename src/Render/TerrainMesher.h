@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "../Editor/SceneEditor.h"
+
+namespace WaterTown {
+
+/**
+ * @brief 地形网格生成器（纯 CPU，不依赖 OpenGL）
+ *
+ * 按 SceneEditor::TERRAIN_CHUNK_SIZE 分块生成顶面顶点与河岸砖块实例。
+ * TerrainRenderer 负责上传与绘制；无 GL 上下文的基准程序也直接调用它。
+ */
+class TerrainMesher {
+public:
+    static constexpr int TERRAIN_TYPE_COUNT = 4;
+    
+    // 定点坐标精度：1/512 米，块内可表示 ±64 米
+    static constexpr float POSITION_QUANT = 512.0f;
+    
+    /**
+     * @brief 压缩顶点（8 字节）：相对块原点的 16 位定点坐标 + 法线索引 + 地形类型
+     *
+     * 着色器中解码：worldPos = uChunkOrigin + position * uPositionScale，
+     * 法线查表，颜色取自按地形类型索引的调色板。
+     */
+    struct TerrainVertex {
+        int16_t position[3];
+        uint8_t normalIndex;  // 0=+Y, 1=-Y, 2=+X, 3=-X, 4=+Z, 5=-Z
+        uint8_t terrainType;  // 0=EMPTY, 1=GRASS, 2=WATER, 3=STONE
+    };
+    
+    static_assert(sizeof(TerrainVertex) == 8, "TerrainVertex must stay tightly packed");
+    
+    /**
+     * @brief 单块砖的实例数据（最小角、尺寸、调色板索引）
+     */
+    struct BrickInstance {
+        glm::vec3 minCorner;
+        glm::vec3 extent;
+        unsigned int colorIndex;  // 0=深色, 1=浅色
+    };
+    
+    /**
+     * @brief 单块的网格结果（顶点已按地形类型排序）
+     */
+    struct ChunkMesh {
+        std::vector<TerrainVertex> vertices;
+        std::vector<BrickInstance> bricks;
+        int32_t typeFirst[TERRAIN_TYPE_COUNT];
+        int32_t typeVertexCount[TERRAIN_TYPE_COUNT];
+    };
+    
+    explicit TerrainMesher(int gridSize);
+    
+    void setGridSize(int size) { m_gridSize = size; }
+    int getGridSize() const { return m_gridSize; }
+    int getChunksPerSide() const;
+    
+    /**
+     * @brief 开关顶面贪心合并（默认开启），关闭时每格输出两个三角形
+     */
+    void setGreedyMeshing(bool enabled) { m_greedyMeshing = enabled; }
+    bool isGreedyMeshing() const { return m_greedyMeshing; }
+    
+    /**
+     * @brief 构建单个地形块的顶面顶点与河岸砖块实例
+     */
+    void buildTerrainVertices(const TerrainMap& map, int chunkX, int chunkZ,
+                              std::vector<TerrainVertex>& outVertices,
+                              std::vector<BrickInstance>& outBricks) const;
+    
+    /**
+     * @brief 生成单块网格并按地形类型排序（线程安全，可在工作线程中执行）
+     */
+    void meshChunk(const TerrainMap& map, int chunkX, int chunkZ, ChunkMesh& outMesh) const;
+    
+    /**
+     * @brief 块原点（世界坐标），压缩顶点相对该点存储
+     */
+    glm::vec3 getChunkOrigin(int chunkX, int chunkZ) const;
+    
+    static glm::vec3 getTerrainColor(TerrainType type);
+    static float getTerrainHeight(TerrainType type);
+
+private:
+    int m_gridSize;
+    bool m_greedyMeshing;
+};
+
+} // namespace WaterTown
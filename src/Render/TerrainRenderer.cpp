@@ -1,7 +1,9 @@
 #include "TerrainRenderer.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "RenderState.h"
 #include "../Editor/SceneEditor.h"
+#include "../Core/ThreadPool.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 #include <algorithm>
@@ -9,206 +11,188 @@
 namespace WaterTown {
 
 TerrainRenderer::TerrainRenderer(int gridSize)
-    : m_gridSize(gridSize), m_planeVAO(0), m_planeVBO(0) {
-    glGenVertexArrays(1, &m_planeVAO);
-    glGenBuffers(1, &m_planeVBO);
+    : m_mesher(gridSize), m_brickMeshVBO(0), m_chunksPerSide(0), m_cachedGeneration(0), m_hasCache(false) {
+    createBrickMesh();
+    createChunks();
 }
 
 TerrainRenderer::~TerrainRenderer() {
-    if (m_planeVAO) glDeleteVertexArrays(1, &m_planeVAO);
-    if (m_planeVBO) glDeleteBuffers(1, &m_planeVBO);
+    destroyChunks();
+    RenderState::deleteBuffers(1, &m_brickMeshVBO);
 }
 
-glm::vec3 TerrainRenderer::getTerrainColor(TerrainType type) const {
-    switch (type) {
-        case TerrainType::GRASS:
-            return glm::vec3(0.3f, 0.7f, 0.3f);
-        case TerrainType::WATER:
-            return glm::vec3(0.2f, 0.4f, 0.9f);
-        case TerrainType::STONE:
-            return glm::vec3(0.7f, 0.7f, 0.7f);
-        case TerrainType::EMPTY:
-            return glm::vec3(0.0f); // 透明/不可见
-        default:
-            return glm::vec3(1.0f, 1.0f, 1.0f);
+void TerrainRenderer::createBrickMesh() {
+    // 单位立方体 [0,1]^3，每块砖在着色器中按 minCorner + aPos * extent 展开
+    const float vertices[] = {
+        // 位置              // 法线
+        0, 0, 1,  0, 0, 1,   1, 0, 1,  0, 0, 1,   1, 1, 1,  0, 0, 1,   // front (+Z)
+        0, 0, 1,  0, 0, 1,   1, 1, 1,  0, 0, 1,   0, 1, 1,  0, 0, 1,
+        1, 0, 0,  0, 0,-1,   0, 0, 0,  0, 0,-1,   0, 1, 0,  0, 0,-1,   // back (-Z)
+        1, 0, 0,  0, 0,-1,   0, 1, 0,  0, 0,-1,   1, 1, 0,  0, 0,-1,
+        0, 0, 0, -1, 0, 0,   0, 0, 1, -1, 0, 0,   0, 1, 1, -1, 0, 0,   // left (-X)
+        0, 0, 0, -1, 0, 0,   0, 1, 1, -1, 0, 0,   0, 1, 0, -1, 0, 0,
+        1, 0, 1,  1, 0, 0,   1, 0, 0,  1, 0, 0,   1, 1, 0,  1, 0, 0,   // right (+X)
+        1, 0, 1,  1, 0, 0,   1, 1, 0,  1, 0, 0,   1, 1, 1,  1, 0, 0,
+        0, 1, 0,  0, 1, 0,   0, 1, 1,  0, 1, 0,   1, 1, 1,  0, 1, 0,   // top (+Y)
+        0, 1, 0,  0, 1, 0,   1, 1, 1,  0, 1, 0,   1, 1, 0,  0, 1, 0,
+        0, 0, 0,  0,-1, 0,   1, 0, 0,  0,-1, 0,   1, 0, 1,  0,-1, 0,   // bottom (-Y)
+        0, 0, 0,  0,-1, 0,   1, 0, 1,  0,-1, 0,   0, 0, 1,  0,-1, 0,
+    };
+
+    glGenBuffers(1, &m_brickMeshVBO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_brickMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TerrainRenderer::createChunks() {
+    m_chunksPerSide = m_mesher.getChunksPerSide();
+    m_chunks.resize(m_chunksPerSide * m_chunksPerSide);
+
+    for (auto& chunk : m_chunks) {
+        glGenVertexArrays(1, &chunk.vao);
+        glGenBuffers(1, &chunk.vbo);
+        glGenVertexArrays(1, &chunk.brickVAO);
+        glGenBuffers(1, &chunk.brickVBO);
+        setupBrickVAO(chunk.brickVAO, chunk.brickVBO);
+        chunk.vertexCount = 0;
+        chunk.brickCount = 0;
+        for (int i = 0; i < TERRAIN_TYPE_COUNT; ++i) {
+            chunk.typeFirst[i] = 0;
+            chunk.typeVertexCount[i] = 0;
+        }
+        chunk.generation = 0;
+        chunk.built = false;
     }
+    m_hasCache = false;
 }
 
-float TerrainRenderer::getTerrainHeight(TerrainType type) const {
-    switch (type) {
-        case TerrainType::GRASS:
-            return 1.0f;
-        case TerrainType::STONE:
-            return 1.1f;
-        case TerrainType::WATER:
-            return SceneEditor::WATER_LEVEL;
-        default:
-            return 0.3f;
+void TerrainRenderer::setGreedyMeshing(bool enabled) {
+    if (m_mesher.isGreedyMeshing() == enabled) {
+        return;
+    }
+    m_mesher.setGreedyMeshing(enabled);
+    // 网格生成方式变化，所有块下次渲染时重建
+    for (auto& chunk : m_chunks) {
+        chunk.built = false;
     }
+    m_hasCache = false;
 }
 
-void TerrainRenderer::buildTerrainVertices(SceneEditor* editor, std::vector<TerrainVertex>& outVertices) {
-    const float cellSize = SceneEditor::CELL_SIZE;
-    const float expand = cellSize * 0.05f; // slight overlap to avoid cracks on the plane
-    const glm::vec3 upNormal(0.0f, 1.0f, 0.0f);
-    const float waterSurface = getTerrainHeight(TerrainType::WATER);
-    const float wallBase = waterSurface - 0.1f; // sink a bit into the river to avoid gaps
-    const float brickScale = 4.0f;
-    const float wallThickness = cellSize * 0.45f * brickScale;
-    const float verticalGap = 0.01f * brickScale;
-    const float horizontalGap = cellSize * 0.04f * brickScale;
-    const float baseBrickHeight = cellSize * 0.15f;
-    const float baseBrickLength = cellSize * 0.25f;
-    const float scaledBrickHeight = baseBrickHeight * brickScale;
-    const float scaledBrickLength = baseBrickLength * brickScale;
-    const glm::vec3 wallColorDark(0.35f, 0.35f, 0.35f);
-    const glm::vec3 wallColorLight(0.45f, 0.45f, 0.45f);
-
-    outVertices.clear();
-    outVertices.reserve(m_gridSize * m_gridSize * 18);
-
-    auto addQuad = [&](const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, const glm::vec3& v3,
-                       const glm::vec3& normal, const glm::vec3& color, int terrainType = 0) {
-        outVertices.push_back({v0, normal, color, terrainType});
-        outVertices.push_back({v1, normal, color, terrainType});
-        outVertices.push_back({v2, normal, color, terrainType});
-        outVertices.push_back({v0, normal, color, terrainType});
-        outVertices.push_back({v2, normal, color, terrainType});
-        outVertices.push_back({v3, normal, color, terrainType});
-    };
+void TerrainRenderer::destroyChunks() {
+    for (auto& chunk : m_chunks) {
+        RenderState::deleteVertexArrays(1, &chunk.vao);
+        RenderState::deleteBuffers(1, &chunk.vbo);
+        RenderState::deleteVertexArrays(1, &chunk.brickVAO);
+        RenderState::deleteBuffers(1, &chunk.brickVBO);
+    }
+    m_chunks.clear();
+    m_chunksPerSide = 0;
+    m_hasCache = false;
+}
 
-    auto addBox = [&](const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec3& color) {
-        glm::vec3 v000(minCorner.x, minCorner.y, minCorner.z);
-        glm::vec3 v001(minCorner.x, minCorner.y, maxCorner.z);
-        glm::vec3 v010(minCorner.x, maxCorner.y, minCorner.z);
-        glm::vec3 v011(minCorner.x, maxCorner.y, maxCorner.z);
-        glm::vec3 v100(maxCorner.x, minCorner.y, minCorner.z);
-        glm::vec3 v101(maxCorner.x, minCorner.y, maxCorner.z);
-        glm::vec3 v110(maxCorner.x, maxCorner.y, minCorner.z);
-        glm::vec3 v111(maxCorner.x, maxCorner.y, maxCorner.z);
-
-        addQuad(v001, v101, v111, v011, glm::vec3(0.0f, 0.0f, 1.0f), color);   // front (+Z)
-        addQuad(v100, v000, v010, v110, glm::vec3(0.0f, 0.0f, -1.0f), color);  // back (-Z)
-        addQuad(v000, v001, v011, v010, glm::vec3(-1.0f, 0.0f, 0.0f), color);  // left (-X)
-        addQuad(v101, v100, v110, v111, glm::vec3(1.0f, 0.0f, 0.0f), color);   // right (+X)
-        addQuad(v010, v011, v111, v110, glm::vec3(0.0f, 1.0f, 0.0f), color);   // top (+Y)
-        addQuad(v000, v100, v101, v001, glm::vec3(0.0f, -1.0f, 0.0f), color);  // bottom (-Y)
-    };
+void TerrainRenderer::setPackedVertexUniforms(Shader* shader) const {
+    shader->setFloat("uPositionScale", 1.0f / TerrainMesher::POSITION_QUANT);
+    shader->setVec3("uTerrainPalette[0]", TerrainMesher::getTerrainColor(TerrainType::EMPTY));
+    shader->setVec3("uTerrainPalette[1]", TerrainMesher::getTerrainColor(TerrainType::GRASS));
+    shader->setVec3("uTerrainPalette[2]", TerrainMesher::getTerrainColor(TerrainType::WATER));
+    shader->setVec3("uTerrainPalette[3]", TerrainMesher::getTerrainColor(TerrainType::STONE));
+}
 
-    auto addWallBricks = [&](float minX, float maxX, float minZ, float maxZ, float topHeight, bool alongZ) {
-        float usableHeight = topHeight - wallBase;
-        if (usableHeight <= 0.05f) {
-            return;
-        }
+void TerrainRenderer::uploadVertices(GLuint vao, GLuint vbo, const std::vector<TerrainVertex>& vertices) {
+    RenderState::bindVertexArray(vao);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TerrainVertex), vertices.data(), GL_STATIC_DRAW);
 
-        float runLength = alongZ ? (maxZ - minZ) : (maxX - minX);
-        if (runLength <= 0.05f) {
-            return;
-        }
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(1, 2, GL_UNSIGNED_BYTE, sizeof(TerrainVertex), (void*)(3 * sizeof(GLshort)));
+    glEnableVertexAttribArray(1);
 
-        float gapY = std::min(verticalGap, usableHeight * 0.25f);
-        float gapRun = std::min(horizontalGap, runLength * 0.5f);
-        float brickHeight = std::min(scaledBrickHeight, usableHeight);
-        float brickLength = std::min(scaledBrickLength, runLength);
+    RenderState::bindVertexArray(0);
+}
 
-        if (brickHeight <= 0.0f || brickLength <= 0.0f) {
-            return;
-        }
+void TerrainRenderer::setupBrickVAO(GLuint vao, GLuint instanceVBO) {
+    RenderState::bindVertexArray(vao);
 
-        int layerIndex = 0;
-        for (float y0 = wallBase; y0 < topHeight - 0.001f; y0 += brickHeight + gapY, ++layerIndex) {
-            float y1 = std::min(y0 + brickHeight, topHeight);
-
-            int segmentIndex = 0;
-            for (float offset = 0.0f; offset < runLength - 0.001f; offset += brickLength + gapRun, ++segmentIndex) {
-                float segStart = (alongZ ? minZ : minX) + offset;
-                float segEnd = std::min(segStart + brickLength, alongZ ? maxZ : maxX);
-                if (segEnd <= segStart + 0.0005f) {
-                    break;
-                }
-
-                glm::vec3 minCorner;
-                glm::vec3 maxCorner;
-                if (alongZ) {
-                    minCorner = glm::vec3(minX, y0, segStart);
-                    maxCorner = glm::vec3(maxX, y1, segEnd);
-                } else {
-                    minCorner = glm::vec3(segStart, y0, minZ);
-                    maxCorner = glm::vec3(segEnd, y1, maxZ);
-                }
-
-                glm::vec3 color = ((layerIndex + segmentIndex) % 2 == 0) ? wallColorDark : wallColorLight;
-                addBox(minCorner, maxCorner, color);
-
-                if (segEnd >= (alongZ ? maxZ : maxX) - 0.001f) {
-                    break;
-                }
-            }
-        }
-    };
+    // 共享的单位立方体
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_brickMeshVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
 
-    for (int z = 0; z < m_gridSize; ++z) {
-        for (int x = 0; x < m_gridSize; ++x) {
-            TerrainType type = editor->getTerrainAt(x, z);
-            // 修改点：同时跳过 WATER 和 EMPTY
-            if (type == TerrainType::WATER || type == TerrainType::EMPTY) {
-                continue; // 水面由 WaterSurface 渲染，空地不渲染
-            }
+    // 逐砖实例数据
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(BrickInstance), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(BrickInstance), (void*)sizeof(glm::vec3));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, sizeof(BrickInstance), (void*)(2 * sizeof(glm::vec3)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    RenderState::bindVertexArray(0);
+}
+
+void TerrainRenderer::uploadChunk(const ChunkMesh& mesh, TerrainChunk& chunk) {
+    uploadVertices(chunk.vao, chunk.vbo, mesh.vertices);
+    chunk.vertexCount = static_cast<GLsizei>(mesh.vertices.size());
+    for (int type = 0; type < TERRAIN_TYPE_COUNT; ++type) {
+        chunk.typeFirst[type] = mesh.typeFirst[type];
+        chunk.typeVertexCount[type] = mesh.typeVertexCount[type];
+    }
+
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, chunk.brickVBO);
+    glBufferData(GL_ARRAY_BUFFER, mesh.bricks.size() * sizeof(BrickInstance), mesh.bricks.data(), GL_STATIC_DRAW);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    chunk.brickCount = static_cast<GLsizei>(mesh.bricks.size());
+}
+
+void TerrainRenderer::updateMeshCache(SceneEditor* editor) {
+    unsigned int generation = editor->getTerrainGeneration();
+    if (m_hasCache && generation == m_cachedGeneration) {
+        return; // 地形未变化，直接使用 GPU 上的常驻网格
+    }
+
+    if (m_chunks.empty()) {
+        createChunks();
+    }
 
-            float height = getTerrainHeight(type);
-            glm::vec3 color = getTerrainColor(type);
-
-            float tileX0 = (x - m_gridSize / 2.0f) * cellSize;
-            float tileZ0 = (z - m_gridSize / 2.0f) * cellSize;
-            float tileX1 = tileX0 + cellSize;
-            float tileZ1 = tileZ0 + cellSize;
-
-            float x0 = tileX0 - expand * 0.5f;
-            float x1 = tileX1 + expand * 0.5f;
-            float z0 = tileZ0 - expand * 0.5f;
-            float z1 = tileZ1 + expand * 0.5f;
-
-            int terrainTypeInt = static_cast<int>(type);
-            TerrainVertex v0{{x0, height, z0}, upNormal, color, terrainTypeInt};
-            TerrainVertex v1{{x1, height, z0}, upNormal, color, terrainTypeInt};
-            TerrainVertex v2{{x1, height, z1}, upNormal, color, terrainTypeInt};
-            TerrainVertex v3{{x0, height, z1}, upNormal, color, terrainTypeInt};
-
-            outVertices.push_back(v0);
-            outVertices.push_back(v1);
-            outVertices.push_back(v2);
-            outVertices.push_back(v0);
-            outVertices.push_back(v2);
-            outVertices.push_back(v3);
-
-            // 检查四个方向是否与河面相邻，生成挡水墙砖块
-            const int directions[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-            for (const auto& dir : directions) {
-                int neighborX = x + dir[0];
-                int neighborZ = z + dir[1];
-                
-                // 注意：如果超出边界，getTerrainAt 可能返回默认值(EMPTY)，所以这里不仅要检测是否是 WATER，
-                // 还要考虑是否是 EMPTY？不，河岸只在陆地和水之间生成。
-                // 如果陆地旁边是空地，不需要生成墙。
-                // 所以只检测邻居是否为 WATER 即可。
-                if (editor->getTerrainAt(neighborX, neighborZ) != TerrainType::WATER) {
-                    continue;
-                }
-
-                if (dir[0] != 0) {
-                    float boundaryX = (dir[0] > 0) ? tileX1 : tileX0;
-                    float minX = (dir[0] > 0) ? boundaryX : boundaryX - wallThickness;
-                    float maxX = (dir[0] > 0) ? boundaryX + wallThickness : boundaryX;
-                    addWallBricks(minX, maxX, tileZ0, tileZ1, height, true);
-                } else {
-                    float boundaryZ = (dir[1] > 0) ? tileZ1 : tileZ0;
-                    float minZ = (dir[1] > 0) ? boundaryZ : boundaryZ - wallThickness;
-                    float maxZ = (dir[1] > 0) ? boundaryZ + wallThickness : boundaryZ;
-                    addWallBricks(tileX0, tileX1, minZ, maxZ, height, false);
-                }
+    // 收集版本号变化的块（笔刷涂抹通常只触及一两个块，加载/清空场景时为全部）
+    std::vector<int> dirtyChunks;
+    std::vector<unsigned int> dirtyGenerations;
+    for (int cz = 0; cz < m_chunksPerSide; ++cz) {
+        for (int cx = 0; cx < m_chunksPerSide; ++cx) {
+            int index = cz * m_chunksPerSide + cx;
+            unsigned int chunkGeneration = editor->getTerrainChunkGeneration(cx, cz);
+            if (m_chunks[index].built && m_chunks[index].generation == chunkGeneration) {
+                continue;
             }
+            dirtyChunks.push_back(index);
+            dirtyGenerations.push_back(chunkGeneration);
         }
     }
+
+    // 工作线程只生成顶点，每块写入独立的缓冲；GL 上传留在主线程
+    const TerrainMap& terrainMap = editor->getTerrainMap();
+    std::vector<ChunkMesh> meshes(dirtyChunks.size());
+    ThreadPool::getInstance().parallelFor(static_cast<int>(dirtyChunks.size()), [&](int i) {
+        int index = dirtyChunks[i];
+        m_mesher.meshChunk(terrainMap, index % m_chunksPerSide, index / m_chunksPerSide, meshes[i]);
+    });
+
+    for (size_t i = 0; i < dirtyChunks.size(); ++i) {
+        TerrainChunk& chunk = m_chunks[dirtyChunks[i]];
+        uploadChunk(meshes[i], chunk);
+        chunk.generation = dirtyGenerations[i];
+        chunk.built = true;
+    }
+
+    m_cachedGeneration = generation;
+    m_hasCache = true;
 }
 
 void TerrainRenderer::render(SceneEditor* editor, Shader* shader, Camera* camera) {
@@ -216,37 +200,43 @@ void TerrainRenderer::render(SceneEditor* editor, Shader* shader, Camera* camera
         return;
     }
 
-    std::vector<TerrainVertex> vertices;
-    buildTerrainVertices(editor, vertices);
-    if (vertices.empty()) {
-        return;
-    }
+    updateMeshCache(editor);
 
     shader->use();
     shader->setBool("uUseVertexColor", true);
     shader->setMat4("uModel", glm::mat4(1.0f));
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-    shader->setVec3("uLightPos", 10.0f, 50.0f, 10.0f);
-    shader->setVec3("uLightColor", 1.0f, 1.0f, 1.0f);
 
-    glBindVertexArray(m_planeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_planeVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TerrainVertex), vertices.data(), GL_DYNAMIC_DRAW);
+    setPackedVertexUniforms(shader);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(sizeof(glm::vec3)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(2 * sizeof(glm::vec3)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribIPointer(3, 1, GL_INT, sizeof(TerrainVertex), (void*)(3 * sizeof(glm::vec3)));
-    glEnableVertexAttribArray(3);
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); ++i) {
+        const TerrainChunk& chunk = m_chunks[i];
+        if (chunk.vertexCount == 0) continue;
+        shader->setVec3("uChunkOrigin", m_mesher.getChunkOrigin(i % m_chunksPerSide, i / m_chunksPerSide));
+        RenderState::bindVertexArray(chunk.vao);
+        glDrawArrays(GL_TRIANGLES, 0, chunk.vertexCount);
+    }
 
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+    shader->setBool("uUseVertexColor", false);
+}
+
+void TerrainRenderer::renderBankWalls(SceneEditor* editor, Shader* shader, Camera* camera) {
+    if (!editor || !shader || !camera) {
+        return;
+    }
+
+    updateMeshCache(editor);
+
+    shader->use();
+    shader->setVec3("uBrickPalette[0]", 0.35f, 0.35f, 0.35f);  // 深色砖
+    shader->setVec3("uBrickPalette[1]", 0.45f, 0.45f, 0.45f);  // 浅色砖
+    shader->setBool("uUseVertexColor", true);
+
+    for (const auto& chunk : m_chunks) {
+        if (chunk.brickCount == 0) continue;
+        RenderState::bindVertexArray(chunk.brickVAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 36, chunk.brickCount);
+    }
 
-    glBindVertexArray(0);
     shader->setBool("uUseVertexColor", false);
 }
 
@@ -255,45 +245,27 @@ void TerrainRenderer::renderByType(SceneEditor* editor, Shader* shader, Camera*
         return;
     }
 
-    // 构建所有顶点
-    std::vector<TerrainVertex> allVertices;
-    buildTerrainVertices(editor, allVertices);
+    updateMeshCache(editor);
     
-    // 过滤出目标类型的顶点
-    std::vector<TerrainVertex> filteredVertices;
     int targetTypeInt = static_cast<int>(targetType);
-    for (const auto& v : allVertices) {
-        if (v.terrainType == targetTypeInt) {
-            filteredVertices.push_back(v);
-        }
-    }
-    
-    if (filteredVertices.empty()) {
+    if (targetTypeInt < 0 || targetTypeInt >= TERRAIN_TYPE_COUNT) {
         return;
     }
 
     shader->use();
     shader->setMat4("uModel", glm::mat4(1.0f));
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-    shader->setVec3("uLightPos", 10.0f, 50.0f, 10.0f);
-    shader->setVec3("uLightColor", 1.0f, 1.0f, 1.0f);
-
-    glBindVertexArray(m_planeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_planeVBO);
-    glBufferData(GL_ARRAY_BUFFER, filteredVertices.size() * sizeof(TerrainVertex), filteredVertices.data(), GL_DYNAMIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(sizeof(glm::vec3)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(2 * sizeof(glm::vec3)));
-    glEnableVertexAttribArray(2);
+    setPackedVertexUniforms(shader);
 
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(filteredVertices.size()));
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); ++i) {
+        const TerrainChunk& chunk = m_chunks[i];
+        GLsizei count = chunk.typeVertexCount[targetTypeInt];
+        if (count == 0) continue;
+        shader->setVec3("uChunkOrigin", m_mesher.getChunkOrigin(i % m_chunksPerSide, i / m_chunksPerSide));
+        RenderState::bindVertexArray(chunk.vao);
+        glDrawArrays(GL_TRIANGLES, chunk.typeFirst[targetTypeInt], count);
+    }
 
-    glBindVertexArray(0);
 }
 
 } // namespace WaterTown
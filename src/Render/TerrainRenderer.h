@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "../Editor/SceneEditor.h"
+#include "TerrainMesher.h"
 
 namespace WaterTown {
 
@@ -35,29 +36,78 @@ public:
      */
     void renderByType(SceneEditor* editor, Shader* shader, Camera* camera, TerrainType type);
     
+    /**
+     * @brief 实例化渲染河岸挡水墙砖块
+     * @param editor 场景编辑器
+     * @param shader 砖块着色器（brick.vert + basic.frag）
+     * @param camera 相机
+     */
+    void renderBankWalls(SceneEditor* editor, Shader* shader, Camera* camera);
+    
     /**
      * @brief 设置网格大小
      */
-    void setGridSize(int size) { m_gridSize = size; }
+    void setGridSize(int size) { m_mesher.setGridSize(size); destroyChunks(); }
+    
+    /**
+     * @brief 开关顶面贪心合并（默认开启），关闭时每格输出两个三角形
+     */
+    void setGreedyMeshing(bool enabled);
+    bool isGreedyMeshing() const { return m_mesher.isGreedyMeshing(); }
     
 private:
-    int m_gridSize;
+    TerrainMesher m_mesher;
+    
+    using TerrainVertex = TerrainMesher::TerrainVertex;
+    using BrickInstance = TerrainMesher::BrickInstance;
+    using ChunkMesh = TerrainMesher::ChunkMesh;
+    static constexpr int TERRAIN_TYPE_COUNT = TerrainMesher::TERRAIN_TYPE_COUNT;
     
-    struct TerrainVertex {
-        glm::vec3 position;
-        glm::vec3 normal;
-        glm::vec3 color;
-        int terrainType;  // 0=EMPTY, 1=GRASS, 2=WATER, 3=STONE
+    GLuint m_brickMeshVBO;  // 共享单位立方体（36 顶点）
+    
+    /**
+     * @brief 地形块（SceneEditor::TERRAIN_CHUNK_SIZE 见方），每块拥有独立的常驻缓冲
+     */
+    struct TerrainChunk {
+        GLuint vao, vbo;
+        GLsizei vertexCount;
+        // 顶点按地形类型排序，各类型在同一缓冲中的区间（renderByType 使用）
+        GLint typeFirst[TERRAIN_TYPE_COUNT];
+        GLsizei typeVertexCount[TERRAIN_TYPE_COUNT];
+        // 河岸砖块实例缓冲
+        GLuint brickVAO, brickVBO;
+        GLsizei brickCount;
+        unsigned int generation;  // 构建时对应的块版本号
+        bool built;
     };
+    std::vector<TerrainChunk> m_chunks;
+    int m_chunksPerSide;
+    
+    // 与 SceneEditor 的全局地形版本号对比，未变化时跳过逐块检查
+    unsigned int m_cachedGeneration;
+    bool m_hasCache;
+    
+    /**
+     * @brief 创建/销毁所有块的 GL 对象
+     */
+    void createChunks();
+    void destroyChunks();
     
-    GLuint m_planeVAO, m_planeVBO;
+    /**
+     * @brief 只重建版本号已过期的块并上传到对应 VBO
+     */
+    void updateMeshCache(SceneEditor* editor);
+    
+    void uploadChunk(const ChunkMesh& mesh, TerrainChunk& chunk);
+    void uploadVertices(GLuint vao, GLuint vbo, const std::vector<TerrainVertex>& vertices);
+    
+    /**
+     * @brief 设置压缩顶点解码所需的 uniform（调色板、定点精度）
+     */
+    void setPackedVertexUniforms(Shader* shader) const;
     
-    void addWallBricks(std::vector<TerrainVertex>& vertices, float x, float z, float size, 
-                      bool top, bool bottom, bool left, bool right);
-                      
-    void buildTerrainVertices(SceneEditor* editor, std::vector<TerrainVertex>& outVertices);
-    glm::vec3 getTerrainColor(TerrainType type) const;
-    float getTerrainHeight(TerrainType type) const;
+    void createBrickMesh();
+    void setupBrickVAO(GLuint vao, GLuint instanceVBO);
 };
 
 } // namespace WaterTown
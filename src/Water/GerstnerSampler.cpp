@@ -0,0 +1,337 @@
+#include "GerstnerSampler.h"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX__)
+#define WATERTOWN_GERSTNER_AVX 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WATERTOWN_GERSTNER_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace WaterTown {
+
+namespace {
+
+/**
+ * @brief 每次调用预先算好的单波常量（与时间、波数有关的部分都折算进来）
+ */
+struct WaveConstants {
+    float kx, kz;        // k * normalize(direction)
+    float phase0;        // -k * speed * time
+    float amplitude;
+    float dispX, dispZ;  // q * a * direction，水平位移
+    float tanXS, tanYC;  // 切线：q * dx * dx * wa，dx * wa
+    float crossS;        // 切线 z / 副法线 x：q * dx * dz * wa
+    float binYC, binZS;  // 副法线：dz * wa，q * dz * dz * wa
+    float velXS, velZS;  // 水平速度：q * a * d * k * speed
+    float velYC;         // 竖直速度：-a * k * speed
+};
+
+// Cody-Waite 分解的 π/2，三项之和等于 π/2，逐项相减保持约化精度
+const float DP1 = 1.5703125f;
+const float DP2 = 4.837512969970703125e-4f;
+const float DP3 = 7.54978995489188216e-8f;
+const float TWO_OVER_PI = 0.636619772367581343f;
+
+// [-π/4, π/4] 上的 sin / cos 多项式系数（Cephes sinf/cosf）
+const float S1 = -1.6666654611e-1f;
+const float S2 = 8.3321608736e-3f;
+const float S3 = -1.9515295891e-4f;
+const float C1 = 4.166664568298827e-2f;
+const float C2 = -1.388731625493765e-3f;
+const float C3 = 2.443315711809948e-5f;
+
+/**
+ * @brief 标量实现，也用于处理批次尾部
+ */
+struct ScalarOps {
+    typedef float V;
+    typedef bool M;
+    static const int WIDTH = 1;
+
+    static V load(const float* p) { return *p; }
+    static void store(float* p, V v) { *p = v; }
+    static V set1(float v) { return v; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V round(V a) { return std::nearbyint(a); }
+    static V quadrant(V j) { return static_cast<float>(static_cast<int>(j) & 3); }
+    static M cmpeq(V a, V b) { return a == b; }
+    static M cmpge(V a, V b) { return a >= b; }
+    static M maskOr(M a, M b) { return a || b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#ifdef WATERTOWN_GERSTNER_SSE
+struct SseOps {
+    typedef __m128 V;
+    typedef __m128 M;
+    static const int WIDTH = 4;
+
+    static V load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+    static V set1(float v) { return _mm_set1_ps(v); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V round(V a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+    static V quadrant(V j) {
+        return _mm_cvtepi32_ps(_mm_and_si128(_mm_cvtps_epi32(j), _mm_set1_epi32(3)));
+    }
+    static M cmpeq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+    static M cmpge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static M maskOr(M a, M b) { return _mm_or_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+#endif
+
+#ifdef WATERTOWN_GERSTNER_AVX
+struct AvxOps {
+    typedef __m256 V;
+    typedef __m256 M;
+    static const int WIDTH = 8;
+
+    static V load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    static V set1(float v) { return _mm256_set1_ps(v); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V round(V a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static V quadrant(V j) {
+        // AVX（非 AVX2）没有 256 位整数与运算，借用浮点按位与
+        __m256 bits = _mm256_castsi256_ps(_mm256_cvtps_epi32(j));
+        __m256 three = _mm256_castsi256_ps(_mm256_set1_epi32(3));
+        return _mm256_cvtepi32_ps(_mm256_castps_si256(_mm256_and_ps(bits, three)));
+    }
+    static M cmpeq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static M cmpge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M maskOr(M a, M b) { return _mm256_or_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm256_or_ps(_mm256_and_ps(m, a), _mm256_andnot_ps(m, b)); }
+};
+#endif
+
+/**
+ * @brief 同时计算 sin / cos：按象限约化到 [-π/4, π/4] 后用多项式近似
+ */
+template <class Ops>
+inline void sinCos(typename Ops::V x, typename Ops::V& outSin, typename Ops::V& outCos) {
+    typedef typename Ops::V V;
+    typedef typename Ops::M M;
+
+    V j = Ops::round(Ops::mul(x, Ops::set1(TWO_OVER_PI)));
+    V r = Ops::sub(x, Ops::mul(j, Ops::set1(DP1)));
+    r = Ops::sub(r, Ops::mul(j, Ops::set1(DP2)));
+    r = Ops::sub(r, Ops::mul(j, Ops::set1(DP3)));
+    V r2 = Ops::mul(r, r);
+
+    V s = Ops::add(Ops::set1(S2), Ops::mul(r2, Ops::set1(S3)));
+    s = Ops::add(Ops::set1(S1), Ops::mul(r2, s));
+    s = Ops::add(r, Ops::mul(Ops::mul(r, r2), s));
+
+    V c = Ops::add(Ops::set1(C2), Ops::mul(r2, Ops::set1(C3)));
+    c = Ops::add(Ops::set1(C1), Ops::mul(r2, c));
+    c = Ops::add(Ops::sub(Ops::set1(1.0f), Ops::mul(Ops::set1(0.5f), r2)), Ops::mul(Ops::mul(r2, r2), c));
+
+    // 象限 q：sin = {s, c, -s, -c}[q]，cos = {c, -s, -c, s}[q]
+    V q = Ops::quadrant(j);
+    M q1 = Ops::cmpeq(q, Ops::set1(1.0f));
+    M q2 = Ops::cmpeq(q, Ops::set1(2.0f));
+    M q3 = Ops::cmpeq(q, Ops::set1(3.0f));
+    M swap = Ops::maskOr(q1, q3);
+    V sinV = Ops::select(swap, c, s);
+    V cosV = Ops::select(swap, s, c);
+    V zero = Ops::set1(0.0f);
+    outSin = Ops::select(Ops::cmpge(q, Ops::set1(2.0f)), Ops::sub(zero, sinV), sinV);
+    outCos = Ops::select(Ops::maskOr(q1, q2), Ops::sub(zero, cosV), cosV);
+}
+
+/**
+ * @brief 采样输出（可选项为空指针时不计算）
+ */
+struct SampleOutputs {
+    float* heights;
+    glm::vec3* normals;
+    glm::vec2* displacements;
+    glm::vec3* velocities;
+};
+
+/**
+ * @brief 以 Ops::WIDTH 为步长处理 [begin, count) 中的完整批次，返回第一个未处理的下标
+ *
+ * 先用不动点迭代 p = x - D(p) 求出位移后恰好落在查询点 x 上的原始网格点 p
+ * （每个波对 D 的导数不超过 steepness / waveCount，迭代是压缩映射），再在 p 处求高度、法线和速度。
+ */
+template <class Ops>
+int sampleRange(const std::vector<WaveConstants>& waves, int iterations, const float* xs, const float* zs,
+                int begin, int count, const SampleOutputs& out) {
+    typedef typename Ops::V V;
+    const int W = Ops::WIDTH;
+    const bool wantNormals = (out.normals != nullptr);
+    const bool wantDisplacements = (out.displacements != nullptr);
+    const bool wantVelocities = (out.velocities != nullptr);
+
+    int i = begin;
+    for (; i + W <= count; i += W) {
+        V x = Ops::load(xs + i);
+        V z = Ops::load(zs + i);
+
+        // 反解水平位移
+        V px = x, pz = z;
+        for (int iter = 0; iter < iterations; ++iter) {
+            V dispX = Ops::set1(0.0f), dispZ = Ops::set1(0.0f);
+            for (const WaveConstants& w : waves) {
+                V phase = Ops::add(Ops::add(Ops::mul(Ops::set1(w.kx), px), Ops::mul(Ops::set1(w.kz), pz)),
+                                   Ops::set1(w.phase0));
+                V s, c;
+                sinCos<Ops>(phase, s, c);
+                dispX = Ops::add(dispX, Ops::mul(Ops::set1(w.dispX), c));
+                dispZ = Ops::add(dispZ, Ops::mul(Ops::set1(w.dispZ), c));
+            }
+            px = Ops::sub(x, dispX);
+            pz = Ops::sub(z, dispZ);
+        }
+
+        V height = Ops::set1(0.0f);
+        V dispX = Ops::set1(0.0f), dispZ = Ops::set1(0.0f);
+        V velX = Ops::set1(0.0f), velY = Ops::set1(0.0f), velZ = Ops::set1(0.0f);
+        V tanX = Ops::set1(1.0f), tanY = Ops::set1(0.0f), tanZ = Ops::set1(0.0f);
+        V binX = Ops::set1(0.0f), binY = Ops::set1(0.0f), binZ = Ops::set1(1.0f);
+
+        for (const WaveConstants& w : waves) {
+            V phase = Ops::add(Ops::add(Ops::mul(Ops::set1(w.kx), px), Ops::mul(Ops::set1(w.kz), pz)),
+                               Ops::set1(w.phase0));
+            V s, c;
+            sinCos<Ops>(phase, s, c);
+
+            height = Ops::add(height, Ops::mul(Ops::set1(w.amplitude), s));
+            if (wantDisplacements) {
+                dispX = Ops::add(dispX, Ops::mul(Ops::set1(w.dispX), c));
+                dispZ = Ops::add(dispZ, Ops::mul(Ops::set1(w.dispZ), c));
+            }
+            if (wantVelocities) {
+                velX = Ops::add(velX, Ops::mul(Ops::set1(w.velXS), s));
+                velY = Ops::add(velY, Ops::mul(Ops::set1(w.velYC), c));
+                velZ = Ops::add(velZ, Ops::mul(Ops::set1(w.velZS), s));
+            }
+            if (wantNormals) {
+                tanX = Ops::sub(tanX, Ops::mul(Ops::set1(w.tanXS), s));
+                tanY = Ops::sub(tanY, Ops::mul(Ops::set1(w.tanYC), c));
+                tanZ = Ops::sub(tanZ, Ops::mul(Ops::set1(w.crossS), s));
+                binX = Ops::sub(binX, Ops::mul(Ops::set1(w.crossS), s));
+                binY = Ops::sub(binY, Ops::mul(Ops::set1(w.binYC), c));
+                binZ = Ops::sub(binZ, Ops::mul(Ops::set1(w.binZS), s));
+            }
+        }
+
+        Ops::store(out.heights + i, height);
+
+        if (wantDisplacements) {
+            float bufX[W], bufZ[W];
+            Ops::store(bufX, dispX);
+            Ops::store(bufZ, dispZ);
+            for (int lane = 0; lane < W; ++lane) {
+                out.displacements[i + lane] = glm::vec2(bufX[lane], bufZ[lane]);
+            }
+        }
+
+        if (wantVelocities) {
+            float bufX[W], bufY[W], bufZ[W];
+            Ops::store(bufX, velX);
+            Ops::store(bufY, velY);
+            Ops::store(bufZ, velZ);
+            for (int lane = 0; lane < W; ++lane) {
+                out.velocities[i + lane] = glm::vec3(bufX[lane], bufY[lane], bufZ[lane]);
+            }
+        }
+
+        if (wantNormals) {
+            // normal = normalize(cross(binormal, tangent))，与 water.vert 一致
+            V nx = Ops::sub(Ops::mul(binY, tanZ), Ops::mul(binZ, tanY));
+            V ny = Ops::sub(Ops::mul(binZ, tanX), Ops::mul(binX, tanZ));
+            V nz = Ops::sub(Ops::mul(binX, tanY), Ops::mul(binY, tanX));
+            V len = Ops::sqrt(Ops::add(Ops::add(Ops::mul(nx, nx), Ops::mul(ny, ny)), Ops::mul(nz, nz)));
+            V invLen = Ops::div(Ops::set1(1.0f), len);
+
+            float bufX[W], bufY[W], bufZ[W];
+            Ops::store(bufX, Ops::mul(nx, invLen));
+            Ops::store(bufY, Ops::mul(ny, invLen));
+            Ops::store(bufZ, Ops::mul(nz, invLen));
+            for (int lane = 0; lane < W; ++lane) {
+                out.normals[i + lane] = glm::vec3(bufX[lane], bufY[lane], bufZ[lane]);
+            }
+        }
+    }
+    return i;
+}
+
+} // namespace
+
+void GerstnerSampler::sample(const GerstnerWave* waves, int waveCount, float time,
+                             const float* xs, const float* zs, int count,
+                             float* outHeights, glm::vec3* outNormals, glm::vec2* outDisplacements,
+                             glm::vec3* outVelocities, int iterations) {
+    if (count <= 0 || !xs || !zs || !outHeights) return;
+
+    // 与 water.vert 的 calculateGerstnerWave 逐项对应
+    std::vector<WaveConstants> constants;
+    constants.reserve(waveCount);
+    for (int i = 0; i < waveCount; ++i) {
+        const GerstnerWave& wave = waves[i];
+        float k = 2.0f * glm::pi<float>() / wave.wavelength;
+        float wa = k * wave.amplitude;
+        float q = (wa > 0.0f) ? wave.steepness / (wa * waveCount) : 0.0f;
+        glm::vec2 d = glm::normalize(wave.direction);
+        float kc = k * wave.speed;
+
+        WaveConstants c;
+        c.kx = k * d.x;
+        c.kz = k * d.y;
+        c.phase0 = -kc * time;
+        c.amplitude = wave.amplitude;
+        c.dispX = q * wave.amplitude * d.x;
+        c.dispZ = q * wave.amplitude * d.y;
+        c.tanXS = q * d.x * d.x * wa;
+        c.tanYC = d.x * wa;
+        c.crossS = q * d.x * d.y * wa;
+        c.binYC = d.y * wa;
+        c.binZS = q * d.y * d.y * wa;
+        c.velXS = c.dispX * kc;
+        c.velZS = c.dispZ * kc;
+        c.velYC = -wave.amplitude * kc;
+        constants.push_back(c);
+    }
+
+    SampleOutputs out = {outHeights, outNormals, outDisplacements, outVelocities};
+    int done = 0;
+#ifdef WATERTOWN_GERSTNER_AVX
+    done = sampleRange<AvxOps>(constants, iterations, xs, zs, done, count, out);
+#endif
+#ifdef WATERTOWN_GERSTNER_SSE
+    done = sampleRange<SseOps>(constants, iterations, xs, zs, done, count, out);
+#endif
+    sampleRange<ScalarOps>(constants, iterations, xs, zs, done, count, out);
+}
+
+const char* GerstnerSampler::getInstructionSet() {
+#if defined(WATERTOWN_GERSTNER_AVX)
+    return "AVX";
+#elif defined(WATERTOWN_GERSTNER_SSE)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace WaterTown
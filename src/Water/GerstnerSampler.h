@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace WaterTown {
+
+/**
+ * @brief 单个 Gerstner 波的参数
+ */
+struct GerstnerWave {
+    glm::vec2 direction;  // 波浪方向
+    float amplitude;      // 振幅
+    float wavelength;     // 波长
+    float speed;          // 速度
+    float steepness;      // 陡峭度
+};
+
+/**
+ * @brief 批量计算 Gerstner 波水面（纯 CPU，不依赖 OpenGL），与 water.vert 的 calculateGerstnerWave 一致
+ *
+ * water.vert 会把网格点水平推移 q * a * d * cos(f)，所以世界坐标 (x, z) 处的水面
+ * 来自另一个原始网格点。这里先用固定次数的不动点迭代反解出该网格点，再求真实的高度/法线/速度。
+ * 按 AVX（8 路）/ SSE2（4 路）/ 标量逐批处理，正弦余弦使用同一套多项式近似，
+ * 因此不同路径、不同批次位置上的同一点结果一致。
+ */
+class GerstnerSampler {
+public:
+    /**
+     * @brief 反解水平位移的默认迭代次数（默认波浪下 3 次后高度误差已降到 float 精度，约 3e-5 m）
+     */
+    static const int DEFAULT_ITERATIONS = 3;
+
+    /**
+     * @brief 批量采样水面
+     * @param waves 波浪参数
+     * @param waveCount 波浪数量
+     * @param time 当前时间（秒）
+     * @param xs 采样点世界 X 坐标
+     * @param zs 采样点世界 Z 坐标
+     * @param count 采样点数量
+     * @param outHeights 输出相对基准面的高度（count 个）
+     * @param outNormals 可选，输出单位法线（count 个）
+     * @param outDisplacements 可选，输出该处水面质点的水平位移 XZ（count 个）
+     * @param outVelocities 可选，输出该处水面质点的速度（count 个）
+     * @param iterations 反解水平位移的迭代次数，0 表示直接在 (x, z) 处求值（不反解）
+     */
+    static void sample(const GerstnerWave* waves, int waveCount, float time,
+                       const float* xs, const float* zs, int count,
+                       float* outHeights,
+                       glm::vec3* outNormals = nullptr,
+                       glm::vec2* outDisplacements = nullptr,
+                       glm::vec3* outVelocities = nullptr,
+                       int iterations = DEFAULT_ITERATIONS);
+
+    /**
+     * @brief 当前编译所用的指令集（"AVX" / "SSE2" / "scalar"）
+     */
+    static const char* getInstructionSet();
+};
+
+} // namespace WaterTown
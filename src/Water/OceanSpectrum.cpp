@@ -0,0 +1,301 @@
+#include "OceanSpectrum.h"
+#include "../Core/ThreadPool.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace WaterTown {
+
+namespace {
+
+const float GRAVITY = 9.81f;
+
+} // namespace
+
+OceanSpectrum::OceanSpectrum()
+    : OceanSpectrum(Settings()) {
+}
+
+OceanSpectrum::OceanSpectrum(const Settings& settings)
+    : m_logResolution(0), m_time(0.0f), m_previousTime(0.0f), m_hasPrevious(false) {
+    setSettings(settings);
+}
+
+void OceanSpectrum::setSettings(const Settings& settings) {
+    m_settings = settings;
+
+    // 分辨率向下取到 2 的幂（radix-2 FFT）
+    int n = 1;
+    m_logResolution = 0;
+    while (n * 2 <= std::max(settings.resolution, 2)) {
+        n *= 2;
+        ++m_logResolution;
+    }
+    m_settings.resolution = n;
+
+    m_bitReverse.resize(n);
+    for (int i = 0; i < n; ++i) {
+        int reversed = 0;
+        for (int bit = 0; bit < m_logResolution; ++bit) {
+            if (i & (1 << bit)) reversed |= 1 << (m_logResolution - 1 - bit);
+        }
+        m_bitReverse[i] = reversed;
+    }
+    m_twiddles.resize(n / 2);
+    for (int i = 0; i < n / 2; ++i) {
+        float angle = 2.0f * glm::pi<float>() * i / n;
+        m_twiddles[i] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    const size_t sampleCount = static_cast<size_t>(n) * n;
+    m_fieldA.assign(sampleCount, Complex(0.0f));
+    m_fieldB.assign(sampleCount, Complex(0.0f));
+    m_fieldC.assign(sampleCount, Complex(0.0f));
+    m_displacements.assign(sampleCount, glm::vec4(0.0f));
+    m_normals.assign(sampleCount, glm::vec4(0.0f, 1.0f, 0.0f, 0.0f));
+    m_previousDisplacements.assign(sampleCount, glm::vec4(0.0f));
+    m_hasPrevious = false;
+
+    generateInitialSpectrum();
+}
+
+float OceanSpectrum::evaluateSpectrum(float kx, float kz) const {
+    float k = std::sqrt(kx * kx + kz * kz);
+    if (k < 1e-6f) return 0.0f;
+
+    glm::vec2 wind = glm::normalize(m_settings.windDirection);
+    float cosTheta = (kx * wind.x + kz * wind.y) / k;
+    float spreading = cosTheta * cosTheta; // cos² 方向分布
+
+    if (m_settings.type == SpectrumType::PHILLIPS) {
+        // P(k) = exp(-1 / (kL)²) / k⁴ · |k̂·ŵ|² · exp(-k² l²)，l 抑制远小于波峰的细碎波
+        float L = m_settings.windSpeed * m_settings.windSpeed / GRAVITY;
+        float l = L * 0.001f;
+        float kL = k * L;
+        return std::exp(-1.0f / (kL * kL)) / (k * k * k * k) * spreading * std::exp(-k * k * l * l);
+    }
+
+    // JONSWAP：S(ω) = g² / ω⁵ · exp(-5/4 (ωp/ω)⁴) · γ^r，再经深水色散 ω² = gk 换到波数域
+    float omega = std::sqrt(GRAVITY * k);
+    float omegaPeak = 22.0f * std::cbrt(GRAVITY * GRAVITY / (m_settings.windSpeed * m_settings.fetch));
+    float sigma = (omega <= omegaPeak) ? 0.07f : 0.09f;
+    float delta = (omega - omegaPeak) / (sigma * omegaPeak);
+    float r = std::exp(-0.5f * delta * delta);
+    float ratio = omegaPeak / omega;
+    float sOmega = GRAVITY * GRAVITY / std::pow(omega, 5.0f)
+                 * std::exp(-1.25f * ratio * ratio * ratio * ratio)
+                 * std::pow(m_settings.peakEnhancement, r);
+    float dOmegaDk = GRAVITY / (2.0f * omega);
+    return sOmega * dOmegaDk / k * spreading;
+}
+
+void OceanSpectrum::generateInitialSpectrum() {
+    const int n = m_settings.resolution;
+    const float L = m_settings.patchSize;
+    m_h0.assign(static_cast<size_t>(n) * n, Complex(0.0f));
+    m_omega.assign(static_cast<size_t>(n) * n, 0.0f);
+
+    std::mt19937 rng(m_settings.seed);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    for (int m = 0; m < n; ++m) {
+        for (int i = 0; i < n; ++i) {
+            float kx = 2.0f * glm::pi<float>() * (i - n / 2) / L;
+            float kz = 2.0f * glm::pi<float>() * (m - n / 2) / L;
+            size_t index = static_cast<size_t>(m) * n + i;
+            float xiR = gaussian(rng);
+            float xiI = gaussian(rng);
+            m_omega[index] = std::sqrt(GRAVITY * std::sqrt(kx * kx + kz * kz));
+
+            // Nyquist 行列没有对应的 -k，置零保证逆变换结果为实数
+            if (i == 0 || m == 0) continue;
+            float amplitude = std::sqrt(evaluateSpectrum(kx, kz) * 0.5f);
+            m_h0[index] = Complex(xiR * amplitude, xiI * amplitude);
+        }
+    }
+
+    // Parseval：均方波高 = Σ|h(k, 0)|²，据此把整体缩放到 rmsHeight
+    double energy = 0.0;
+    for (int m = 0; m < n; ++m) {
+        for (int i = 0; i < n; ++i) {
+            size_t index = static_cast<size_t>(m) * n + i;
+            size_t mirror = static_cast<size_t>((n - m) % n) * n + (n - i) % n;
+            energy += std::norm(m_h0[index] + std::conj(m_h0[mirror]));
+        }
+    }
+    if (energy > 0.0) {
+        float scale = m_settings.rmsHeight / static_cast<float>(std::sqrt(energy));
+        for (Complex& h : m_h0) {
+            h *= scale;
+        }
+    }
+    m_hasPrevious = false;
+}
+
+void OceanSpectrum::inverseFft(Complex* data) const {
+    const int n = m_settings.resolution;
+    for (int i = 0; i < n; ++i) {
+        int j = m_bitReverse[i];
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (int size = 2; size <= n; size *= 2) {
+        int half = size / 2;
+        int step = n / size;
+        for (int start = 0; start < n; start += size) {
+            for (int k = 0; k < half; ++k) {
+                Complex u = data[start + k];
+                Complex v = data[start + k + half] * m_twiddles[k * step];
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+        }
+    }
+}
+
+void OceanSpectrum::inverseFft2D() {
+    const int n = m_settings.resolution;
+    ThreadPool& pool = ThreadPool::getInstance();
+
+    // 行：各行数据连续，直接原地变换
+    pool.parallelFor(n, [&](int row) {
+        inverseFft(&m_fieldA[static_cast<size_t>(row) * n]);
+        inverseFft(&m_fieldB[static_cast<size_t>(row) * n]);
+        inverseFft(&m_fieldC[static_cast<size_t>(row) * n]);
+    });
+
+    // 列：拷到连续缓冲再变换
+    pool.parallelFor(n, [&](int col) {
+        std::vector<Complex> column(n);
+        std::vector<Complex>* fields[3] = {&m_fieldA, &m_fieldB, &m_fieldC};
+        for (std::vector<Complex>* field : fields) {
+            for (int row = 0; row < n; ++row) {
+                column[row] = (*field)[static_cast<size_t>(row) * n + col];
+            }
+            inverseFft(column.data());
+            for (int row = 0; row < n; ++row) {
+                (*field)[static_cast<size_t>(row) * n + col] = column[row];
+            }
+        }
+    });
+}
+
+void OceanSpectrum::update(float time) {
+    const int n = m_settings.resolution;
+    const float L = m_settings.patchSize;
+
+    // 同一时刻重复调用不改变结果，也不破坏速度差分
+    if (m_hasPrevious && time == m_time) return;
+
+    // 填充频域：h(k, t) = h0(k) e^{iωt} + conj(h0(-k)) e^{-iωt}
+    ThreadPool::getInstance().parallelFor(n, [&](int m) {
+        for (int i = 0; i < n; ++i) {
+            size_t index = static_cast<size_t>(m) * n + i;
+            size_t mirror = static_cast<size_t>((n - m) % n) * n + (n - i) % n;
+            float kx = 2.0f * glm::pi<float>() * (i - n / 2) / L;
+            float kz = 2.0f * glm::pi<float>() * (m - n / 2) / L;
+            float k = std::sqrt(kx * kx + kz * kz);
+
+            float phase = m_omega[index] * time;
+            Complex rotation(std::cos(phase), std::sin(phase));
+            Complex h = m_h0[index] * rotation + std::conj(m_h0[mirror]) * std::conj(rotation);
+
+            // 水平位移 D = -i k/|k| h，斜率 = i k h；两个实数场合并为一次复数 FFT
+            Complex I(0.0f, 1.0f);
+            Complex dx = (k > 1e-6f) ? -I * (kx / k) * h : Complex(0.0f);
+            Complex dz = (k > 1e-6f) ? -I * (kz / k) * h : Complex(0.0f);
+            Complex slopeX = I * kx * h;
+            Complex slopeZ = I * kz * h;
+
+            m_fieldA[index] = h + I * dx;
+            m_fieldB[index] = dz + I * slopeX;
+            m_fieldC[index] = slopeZ;
+        }
+    });
+
+    inverseFft2D();
+
+    if (m_time != time) {
+        m_previousDisplacements.swap(m_displacements);
+        m_previousTime = m_time;
+        m_hasPrevious = true;
+    }
+    m_time = time;
+
+    // 频谱以 k = 0 为中心，空间域每隔一个采样点符号翻转一次
+    const float lambda = m_settings.choppiness;
+    ThreadPool::getInstance().parallelFor(n, [&](int j) {
+        for (int i = 0; i < n; ++i) {
+            size_t index = static_cast<size_t>(j) * n + i;
+            float sign = ((i + j) & 1) ? -1.0f : 1.0f;
+            float height = m_fieldA[index].real() * sign;
+            float dx = m_fieldA[index].imag() * sign * lambda;
+            float dz = m_fieldB[index].real() * sign * lambda;
+            float slopeX = m_fieldB[index].imag() * sign;
+            float slopeZ = m_fieldC[index].real() * sign;
+
+            m_displacements[index] = glm::vec4(dx, height, dz, 0.0f);
+            m_normals[index] = glm::vec4(glm::normalize(glm::vec3(-slopeX, 1.0f, -slopeZ)), 0.0f);
+        }
+    });
+}
+
+glm::vec4 OceanSpectrum::sampleField(const std::vector<glm::vec4>& field, float x, float z) const {
+    const int n = m_settings.resolution;
+    float fx = x / m_settings.patchSize * n;
+    float fz = z / m_settings.patchSize * n;
+    float floorX = std::floor(fx);
+    float floorZ = std::floor(fz);
+    float tx = fx - floorX;
+    float tz = fz - floorZ;
+
+    // 与 GL_REPEAT 相同的平铺
+    int i0 = static_cast<int>(floorX) % n;
+    int j0 = static_cast<int>(floorZ) % n;
+    if (i0 < 0) i0 += n;
+    if (j0 < 0) j0 += n;
+    int i1 = (i0 + 1) % n;
+    int j1 = (j0 + 1) % n;
+
+    const glm::vec4& v00 = field[static_cast<size_t>(j0) * n + i0];
+    const glm::vec4& v10 = field[static_cast<size_t>(j0) * n + i1];
+    const glm::vec4& v01 = field[static_cast<size_t>(j1) * n + i0];
+    const glm::vec4& v11 = field[static_cast<size_t>(j1) * n + i1];
+    return glm::mix(glm::mix(v00, v10, tx), glm::mix(v01, v11, tx), tz);
+}
+
+void OceanSpectrum::sample(const float* xs, const float* zs, int count,
+                           float* outHeights, glm::vec3* outNormals, glm::vec2* outDisplacements,
+                           glm::vec3* outVelocities, int iterations) const {
+    float dt = m_time - m_previousTime;
+    bool hasVelocity = m_hasPrevious && dt > 0.0f;
+
+    for (int i = 0; i < count; ++i) {
+        // 反解水平位移：找到位移后落在 (x, z) 的采样位置 p
+        float px = xs[i];
+        float pz = zs[i];
+        for (int iter = 0; iter < iterations; ++iter) {
+            glm::vec4 d = sampleField(m_displacements, px, pz);
+            px = xs[i] - d.x;
+            pz = zs[i] - d.z;
+        }
+
+        glm::vec4 d = sampleField(m_displacements, px, pz);
+        outHeights[i] = d.y;
+        if (outDisplacements) {
+            outDisplacements[i] = glm::vec2(d.x, d.z);
+        }
+        if (outNormals) {
+            outNormals[i] = glm::normalize(glm::vec3(sampleField(m_normals, px, pz)));
+        }
+        if (outVelocities) {
+            if (hasVelocity) {
+                glm::vec4 previous = sampleField(m_previousDisplacements, px, pz);
+                outVelocities[i] = glm::vec3(d - previous) / dt;
+            } else {
+                outVelocities[i] = glm::vec3(0.0f);
+            }
+        }
+    }
+}
+
+} // namespace WaterTown
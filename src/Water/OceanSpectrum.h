@@ -0,0 +1,132 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <complex>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief FFT 海浪（Tessendorf）：按海浪谱生成初始频谱，每个模拟步在 CPU 上做逆 FFT 得到位移/法线场
+ *
+ * 结果是边长 patchSize 的周期性图块，可无缝平铺。渲染时上传为纹理由 water.vert 采样，
+ * 物理查询对同一份数据做双线性插值，因此两者看到的是同一个水面。纯 CPU，不依赖 OpenGL。
+ */
+class OceanSpectrum {
+public:
+    /**
+     * @brief 海浪谱类型
+     */
+    enum class SpectrumType {
+        PHILLIPS,   // Phillips 谱（充分发展的风浪）
+        JONSWAP     // JONSWAP 谱（有限风区，峰值更尖）
+    };
+
+    /**
+     * @brief 海浪参数
+     */
+    struct Settings {
+        int resolution = 128;                             // 每边采样数（2 的幂）
+        float patchSize = 40.0f;                          // 图块边长（米），160m 水面平铺 4x4
+        SpectrumType type = SpectrumType::PHILLIPS;
+        float windSpeed = 4.0f;                           // 风速（米/秒）
+        glm::vec2 windDirection = glm::vec2(1.0f, 0.4f);  // 风向（XZ）
+        float fetch = 2000.0f;                            // 风区长度（米，仅 JONSWAP）
+        float peakEnhancement = 3.3f;                     // 峰值增强因子 γ（仅 JONSWAP）
+        float rmsHeight = 0.05f;                          // 频谱整体缩放到的均方根波高（米）
+        float choppiness = 0.8f;                          // 水平位移强度，< 1 时水面不自交
+        unsigned int seed = 1;                            // 随机种子
+    };
+
+    OceanSpectrum();
+    explicit OceanSpectrum(const Settings& settings);
+
+    /**
+     * @brief 更换参数并重新生成初始频谱
+     */
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief 演化频谱到 time 时刻并做逆 FFT（行、列两趟都在线程池上并行）
+     */
+    void update(float time);
+
+    /**
+     * @brief 每个采样点的位移 (dx, h, dz, 0)，行优先，采样点 (i, j) 对应图块内坐标 (i, j) * patchSize / resolution
+     */
+    const std::vector<glm::vec4>& getDisplacements() const { return m_displacements; }
+
+    /**
+     * @brief 每个采样点的单位法线 (nx, ny, nz, 0)，排列同 getDisplacements
+     */
+    const std::vector<glm::vec4>& getNormals() const { return m_normals; }
+
+    int getResolution() const { return m_settings.resolution; }
+    float getPatchSize() const { return m_settings.patchSize; }
+
+    /**
+     * @brief 批量查询最近一次 update 的水面（与 GPU 的双线性 + 平铺采样一致，并反解水平位移）
+     * @param xs 采样点世界 X 坐标
+     * @param zs 采样点世界 Z 坐标
+     * @param count 采样点数量
+     * @param outHeights 输出相对基准面的高度
+     * @param outNormals 可选，输出单位法线
+     * @param outDisplacements 可选，输出该处水面质点的水平位移 XZ
+     * @param outVelocities 可选，输出该处水面质点的速度（由相邻两次 update 差分得到）
+     * @param iterations 反解水平位移的迭代次数
+     */
+    void sample(const float* xs, const float* zs, int count,
+                float* outHeights,
+                glm::vec3* outNormals = nullptr,
+                glm::vec2* outDisplacements = nullptr,
+                glm::vec3* outVelocities = nullptr,
+                int iterations = 3) const;
+
+private:
+    typedef std::complex<float> Complex;
+
+    Settings m_settings;
+    int m_logResolution;
+    std::vector<Complex> m_h0;            // 初始频谱 h0(k)
+    std::vector<float> m_omega;           // 色散关系 ω(k)
+    std::vector<int> m_bitReverse;        // FFT 位逆序表
+    std::vector<Complex> m_twiddles;      // 逆 FFT 旋转因子 e^{+2πik/N}
+
+    // 每步复用的频域缓冲：(h + i*dx)、(dz + i*slopeX)、(slopeZ)
+    std::vector<Complex> m_fieldA, m_fieldB, m_fieldC;
+
+    std::vector<glm::vec4> m_displacements;
+    std::vector<glm::vec4> m_normals;
+    std::vector<glm::vec4> m_previousDisplacements; // 上一步的位移，用于求速度
+    float m_time;
+    float m_previousTime;
+    bool m_hasPrevious;
+
+    /**
+     * @brief 生成 h0(k) 并缩放到 rmsHeight
+     */
+    void generateInitialSpectrum();
+
+    /**
+     * @brief 海浪谱能量密度 P(k)（未归一化，整体缩放在 generateInitialSpectrum 中完成）
+     */
+    float evaluateSpectrum(float kx, float kz) const;
+
+    /**
+     * @brief 原地逆 FFT（未除以 N），data 为连续的 resolution 个复数
+     */
+    void inverseFft(Complex* data) const;
+
+    /**
+     * @brief 对三个频域缓冲做二维逆 FFT（先行后列）
+     */
+    void inverseFft2D();
+
+    /**
+     * @brief 平铺 + 双线性采样位移场（坐标为世界 XZ）
+     */
+    glm::vec4 sampleField(const std::vector<glm::vec4>& field, float x, float z) const;
+};
+
+} // namespace WaterTown
@@ -0,0 +1,194 @@
+#include "WakeSimulation.h"
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WATERTOWN_WAKE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace WaterTown {
+
+namespace {
+
+// 每个线程池任务处理的行数（一行只有几百个格子，逐行派发的调度开销比计算还大）
+const int ROWS_PER_BAND = 16;
+
+// 单位速度、单位时间压低的水深（米），船速 5 m/s 时尾迹波高约 5 cm
+const float HULL_STRENGTH = 0.02f;
+
+} // namespace
+
+WakeSimulation::WakeSimulation()
+    : WakeSimulation(Settings()) {
+}
+
+WakeSimulation::WakeSimulation(const Settings& settings)
+    : m_originCell(0), m_accumulator(0.0f) {
+    setSettings(settings);
+}
+
+void WakeSimulation::setSettings(const Settings& settings) {
+    m_settings = settings;
+    m_settings.resolution = std::max(m_settings.resolution, 8);
+    const int n = m_settings.resolution;
+
+    m_columnDamping.resize(n);
+    for (int i = 0; i < n; ++i) {
+        m_columnDamping[i] = spongeFactor(i);
+    }
+    reset();
+}
+
+void WakeSimulation::reset() {
+    const size_t cellCount = static_cast<size_t>(m_settings.resolution) * m_settings.resolution;
+    m_current.assign(cellCount, 0.0f);
+    m_previous.assign(cellCount, 0.0f);
+    m_scratch.assign(cellCount, 0.0f);
+    m_accumulator = 0.0f;
+}
+
+float WakeSimulation::spongeFactor(int index) const {
+    const int n = m_settings.resolution;
+    const int sponge = m_settings.spongeCells;
+    int edge = std::min(index, n - 1 - index);
+    if (sponge <= 0 || edge >= sponge) return 1.0f;
+    float t = 1.0f - static_cast<float>(edge) / sponge;
+    return 1.0f - 0.08f * t * t;
+}
+
+void WakeSimulation::setCenter(const glm::vec2& center) {
+    const int n = m_settings.resolution;
+    glm::ivec2 originCell = glm::ivec2(glm::floor(center / m_settings.cellSize)) - glm::ivec2(n / 2);
+    glm::ivec2 shift = originCell - m_originCell;
+    if (shift.x == 0 && shift.y == 0) return;
+
+    shiftField(m_current, shift.x, shift.y);
+    shiftField(m_previous, shift.x, shift.y);
+    m_originCell = originCell;
+}
+
+void WakeSimulation::shiftField(std::vector<float>& field, int dx, int dz) {
+    const int n = m_settings.resolution;
+    std::fill(m_scratch.begin(), m_scratch.end(), 0.0f);
+
+    // 新窗口第 j 行第 i 列 = 旧窗口第 j + dz 行第 i + dx 列
+    int colBegin = std::max(0, -dx);
+    int colEnd = std::min(n, n - dx);
+    if (colBegin < colEnd) {
+        for (int j = std::max(0, -dz); j < std::min(n, n - dz); ++j) {
+            const float* src = &field[static_cast<size_t>(j + dz) * n + colBegin + dx];
+            std::copy(src, src + (colEnd - colBegin), &m_scratch[static_cast<size_t>(j) * n + colBegin]);
+        }
+    }
+    field.swap(m_scratch);
+}
+
+void WakeSimulation::applyHull(const glm::vec2& position, const glm::vec2& forward,
+                               float length, float width, float speed, float deltaTime) {
+    if (speed <= 0.0f || deltaTime <= 0.0f) return;
+
+    const int n = m_settings.resolution;
+    const float cellSize = m_settings.cellSize;
+    glm::vec2 right(forward.y, -forward.x);
+
+    // 椭圆略大于船体，保证低分辨率下也至少覆盖几个格子
+    float halfLength = 0.5f * length + cellSize;
+    float halfWidth = 0.5f * width + cellSize;
+    float amount = HULL_STRENGTH * speed * deltaTime;
+
+    glm::vec2 local = position / cellSize - glm::vec2(m_originCell);
+    int reach = static_cast<int>(std::ceil(halfLength / cellSize));
+    int iBegin = std::max(1, static_cast<int>(local.x) - reach);
+    int iEnd = std::min(n - 1, static_cast<int>(local.x) + reach + 1);
+    int jBegin = std::max(1, static_cast<int>(local.y) - reach);
+    int jEnd = std::min(n - 1, static_cast<int>(local.y) + reach + 1);
+
+    for (int j = jBegin; j < jEnd; ++j) {
+        for (int i = iBegin; i < iEnd; ++i) {
+            glm::vec2 delta = (glm::vec2(m_originCell + glm::ivec2(i, j)) * cellSize) - position;
+            float along = glm::dot(delta, forward) / halfLength;
+            float side = glm::dot(delta, right) / halfWidth;
+            float r2 = along * along + side * side;
+            if (r2 >= 1.0f) continue;
+            float falloff = (1.0f - r2) * (1.0f - r2);
+            m_current[static_cast<size_t>(j) * n + i] -= amount * falloff;
+        }
+    }
+}
+
+int WakeSimulation::update(float deltaTime) {
+    const float timeStep = m_settings.timeStep;
+    m_accumulator += deltaTime;
+
+    int steps = 0;
+    while (m_accumulator >= timeStep && steps < m_settings.maxStepsPerUpdate) {
+        step();
+        m_accumulator -= timeStep;
+        ++steps;
+    }
+
+    // 超出预算的时间直接丢弃，卡顿之后不会连续补算
+    m_accumulator = std::min(m_accumulator, timeStep);
+    return steps;
+}
+
+void WakeSimulation::step() {
+    const int n = m_settings.resolution;
+    const int interiorRows = n - 2;
+    const int bandCount = (interiorRows + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+
+    auto runBand = [&](int band) {
+        int rowBegin = 1 + band * ROWS_PER_BAND;
+        stepRows(rowBegin, std::min(rowBegin + ROWS_PER_BAND, n - 1));
+    };
+    if (m_settings.multithreaded && bandCount > 1) {
+        ThreadPool::getInstance().parallelFor(bandCount, runBand);
+    } else {
+        for (int band = 0; band < bandCount; ++band) {
+            runBand(band);
+        }
+    }
+
+    // 新结果写在 m_previous 中
+    m_current.swap(m_previous);
+}
+
+void WakeSimulation::stepRows(int rowBegin, int rowEnd) {
+    const int n = m_settings.resolution;
+    const float courant = m_settings.waveSpeed * m_settings.timeStep / m_settings.cellSize;
+    const float k = std::min(courant * courant, 0.5f);
+    const float center = 2.0f - 4.0f * k;
+
+    for (int j = rowBegin; j < rowEnd; ++j) {
+        const float* up = &m_current[static_cast<size_t>(j - 1) * n];
+        const float* row = &m_current[static_cast<size_t>(j) * n];
+        const float* down = &m_current[static_cast<size_t>(j + 1) * n];
+        float* out = &m_previous[static_cast<size_t>(j) * n];  // 读 h_prev、写 h_next，同一位置原地更新
+        const float* columnDamping = m_columnDamping.data();
+        const float rowDamping = m_settings.damping * spongeFactor(j);
+
+        int i = 1;
+#ifdef WATERTOWN_WAKE_SSE
+        const __m128 vCenter = _mm_set1_ps(center);
+        const __m128 vK = _mm_set1_ps(k);
+        const __m128 vRowDamping = _mm_set1_ps(rowDamping);
+        for (; i + 4 <= n - 1; i += 4) {
+            __m128 neighbours = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row + i - 1), _mm_loadu_ps(row + i + 1)),
+                                           _mm_add_ps(_mm_loadu_ps(up + i), _mm_loadu_ps(down + i)));
+            __m128 next = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(vCenter, _mm_loadu_ps(row + i)),
+                                                _mm_mul_ps(vK, neighbours)),
+                                     _mm_loadu_ps(out + i));
+            next = _mm_mul_ps(next, _mm_mul_ps(vRowDamping, _mm_loadu_ps(columnDamping + i)));
+            _mm_storeu_ps(out + i, next);
+        }
+#endif
+        for (; i < n - 1; ++i) {
+            float neighbours = row[i - 1] + row[i + 1] + up[i] + down[i];
+            out[i] = (center * row[i] + k * neighbours - out[i]) * rowDamping * columnDamping[i];
+        }
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 船只尾迹/涟漪：跟随船只移动的二维波动方程高度场（纯 CPU，不依赖 OpenGL）
+ *
+ * 固定步长积分 h' = 2h - h_prev + k·∇²h 并乘以阻尼，内层循环按 SSE2 四路计算五点模板，
+ * 行按条带分给线程池。窗口中心对齐到格子，船只移动整格时整体平移数据，尾迹留在原处的水面上。
+ * 边缘若干格为吸收层，波到达窗口边界时逐渐衰减而不反射。
+ */
+class WakeSimulation {
+public:
+    /**
+     * @brief 模拟参数
+     */
+    struct Settings {
+        int resolution = 256;         // 每边格子数
+        float cellSize = 0.125f;      // 格子边长（米），默认窗口 32m
+        float waveSpeed = 2.0f;       // 波速（米/秒），需满足 (waveSpeed * timeStep / cellSize)² <= 0.5
+        float damping = 0.985f;       // 每步阻尼
+        float timeStep = 1.0f / 60.0f; // 固定步长（秒）
+        int maxStepsPerUpdate = 2;    // 每次 update 最多积分的步数，超出的时间直接丢弃（固定预算）
+        int spongeCells = 12;         // 边缘吸收层宽度（格子数）
+        bool multithreaded = true;    // 行条带是否分给线程池
+    };
+
+    WakeSimulation();
+    explicit WakeSimulation(const Settings& settings);
+
+    /**
+     * @brief 更换参数并清空高度场
+     */
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const { return m_settings; }
+
+    /**
+     * @brief 清空高度场
+     */
+    void reset();
+
+    /**
+     * @brief 把窗口中心移到 center 附近（对齐到格子），已有的波随世界坐标保持不动
+     */
+    void setCenter(const glm::vec2& center);
+
+    /**
+     * @brief 船体排开的水：在船体椭圆内按速度压低水面，作为波源
+     * @param position 船体中心 XZ
+     * @param forward 船头方向 XZ（单位向量）
+     * @param length 船长
+     * @param width 船宽
+     * @param speed 船速（米/秒），静止的船不产生尾迹
+     * @param deltaTime 本帧时长（秒）
+     */
+    void applyHull(const glm::vec2& position, const glm::vec2& forward,
+                   float length, float width, float speed, float deltaTime);
+
+    /**
+     * @brief 推进 deltaTime（按固定步长积分，最多 maxStepsPerUpdate 步）
+     * @return 实际积分的步数
+     */
+    int update(float deltaTime);
+
+    /**
+     * @brief 积分一步
+     */
+    void step();
+
+    /**
+     * @brief 当前高度场（行优先，resolution x resolution，第 j 行第 i 列对应 getOrigin() + (i, j) * cellSize）
+     */
+    const std::vector<float>& getHeights() const { return m_current; }
+
+    int getResolution() const { return m_settings.resolution; }
+    float getCellSize() const { return m_settings.cellSize; }
+    float getSize() const { return m_settings.resolution * m_settings.cellSize; }
+
+    /**
+     * @brief 窗口 (0, 0) 格子的世界 XZ
+     */
+    glm::vec2 getOrigin() const { return glm::vec2(m_originCell) * m_settings.cellSize; }
+
+private:
+    Settings m_settings;
+    std::vector<float> m_current;
+    std::vector<float> m_previous;
+    std::vector<float> m_scratch;      // 平移窗口时的临时缓冲
+    std::vector<float> m_columnDamping; // 每列的阻尼（含吸收层），行阻尼在积分时相乘
+    glm::ivec2 m_originCell;
+    float m_accumulator;
+
+    /**
+     * @brief 积分 [rowBegin, rowEnd) 行（不含首末两行）
+     */
+    void stepRows(int rowBegin, int rowEnd);
+
+    /**
+     * @brief 第 index 行/列的吸收层阻尼系数（内部为 1）
+     */
+    float spongeFactor(int index) const;
+
+    /**
+     * @brief 把 field 平移 (dx, dz) 格，移入的区域清零
+     */
+    void shiftField(std::vector<float>& field, int dx, int dz);
+};
+
+} // namespace WaterTown
@@ -0,0 +1,145 @@
+#include "WaterClipmap.h"
+#include "../Render/Shader.h"
+#include "../Render/RenderState.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+WaterClipmap::WaterClipmap()
+    : m_VAO(0), m_VBO(0), m_EBO(0), m_gridSize(0), m_baseSpacing(1.0f), m_levelCount(0) {
+    for (int i = 0; i < 5; ++i) {
+        m_sectionCounts[i] = 0;
+        m_sectionOffsets[i] = nullptr;
+    }
+}
+
+WaterClipmap::~WaterClipmap() {
+    if (m_VAO) RenderState::deleteVertexArrays(1, &m_VAO);
+    if (m_VBO) RenderState::deleteBuffers(1, &m_VBO);
+    if (m_EBO) RenderState::deleteBuffers(1, &m_EBO);
+}
+
+void WaterClipmap::build(int gridSize, float baseSpacing, float coverage) {
+    m_gridSize = std::max(4, gridSize / 4 * 4);
+    m_baseSpacing = baseSpacing;
+
+    // 层数：最外层边长 gridSize * baseSpacing * 2^(L-1) >= coverage
+    m_levelCount = 1;
+    while (m_gridSize * m_baseSpacing * static_cast<float>(1 << (m_levelCount - 1)) < coverage
+           && m_levelCount < 16) {
+        ++m_levelCount;
+    }
+
+    // 顶点只存格点编号，世界坐标在着色器中按层换算
+    const int n = m_gridSize;
+    std::vector<float> vertices;
+    vertices.reserve(static_cast<size_t>(n + 1) * (n + 1) * 5);
+    for (int z = 0; z <= n; ++z) {
+        for (int x = 0; x <= n; ++x) {
+            vertices.push_back(static_cast<float>(x));
+            vertices.push_back(0.0f);
+            vertices.push_back(static_cast<float>(z));
+            vertices.push_back(static_cast<float>(x) / n);
+            vertices.push_back(static_cast<float>(z) / n);
+        }
+    }
+
+    // 内层恰好占据外层中间 n/2 x n/2 格，起点偏移 n/4 + {0, 1}
+    std::vector<unsigned int> indices;
+    for (int section = 0; section < 5; ++section) {
+        m_sectionOffsets[section] = reinterpret_cast<const void*>(
+            static_cast<uintptr_t>(indices.size() * sizeof(unsigned int)));
+
+        int holeMinX = n, holeMinZ = n;
+        if (section > 0) {
+            holeMinX = n / 4 + (section - 1) % 2;
+            holeMinZ = n / 4 + (section - 1) / 2;
+        }
+        for (int z = 0; z < n; ++z) {
+            for (int x = 0; x < n; ++x) {
+                if (x >= holeMinX && x < holeMinX + n / 2 && z >= holeMinZ && z < holeMinZ + n / 2) {
+                    continue;
+                }
+                unsigned int topLeft = z * (n + 1) + x;
+                unsigned int topRight = topLeft + 1;
+                unsigned int bottomLeft = (z + 1) * (n + 1) + x;
+                unsigned int bottomRight = bottomLeft + 1;
+
+                indices.push_back(topLeft);
+                indices.push_back(bottomLeft);
+                indices.push_back(topRight);
+
+                indices.push_back(topRight);
+                indices.push_back(bottomLeft);
+                indices.push_back(bottomRight);
+            }
+        }
+        m_sectionCounts[section] = static_cast<GLsizei>(
+            indices.size() - reinterpret_cast<uintptr_t>(m_sectionOffsets[section]) / sizeof(unsigned int));
+    }
+
+    if (m_VAO == 0) glGenVertexArrays(1, &m_VAO);
+    if (m_VBO == 0) glGenBuffers(1, &m_VBO);
+    if (m_EBO == 0) glGenBuffers(1, &m_EBO);
+
+    RenderState::bindVertexArray(m_VAO);
+
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    RenderState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // 位置属性（格点编号）
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // UV 属性
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    RenderState::bindVertexArray(0);
+}
+
+int WaterClipmap::getTriangleCount() const {
+    if (m_levelCount == 0) return 0;
+    return (m_sectionCounts[0] + (m_levelCount - 1) * m_sectionCounts[1]) / 3;
+}
+
+void WaterClipmap::draw(Shader* shader, const glm::vec2& focus) {
+    if (!shader || m_VAO == 0) return;
+
+    const float halfCells = m_gridSize * 0.5f;
+    shader->setVec2("uClipmapCenter", focus);
+
+    RenderState::bindVertexArray(m_VAO);
+    glm::vec2 innerCenter(0.0f);
+    for (int level = 0; level < m_levelCount; ++level) {
+        float spacing = m_baseSpacing * static_cast<float>(1 << level);
+
+        // 中心对齐到 2 倍间距，内层原点（对齐到本层间距）随之落在本层格点上
+        glm::vec2 center = glm::floor(focus / (2.0f * spacing)) * (2.0f * spacing);
+        glm::vec2 origin = center - halfCells * spacing;
+
+        // 焦点到本层边界的切比雪夫距离至少为 halfCells * spacing - 2 * spacing，在此之前完成过渡
+        float morphEnd = (halfCells - 2.0f) * spacing;
+        float morphStart = morphEnd - halfCells * 0.25f * spacing;
+        shader->setVec2("uClipmapOrigin", origin);
+        shader->setFloat("uClipmapSpacing", spacing);
+        shader->setVec2("uClipmapMorphRange", glm::vec2(morphStart, morphEnd));
+
+        int section = 0;
+        if (level > 0) {
+            glm::vec2 holeOffset = (innerCenter - center) / spacing;
+            section = 1 + static_cast<int>(std::round(holeOffset.x)) + 2 * static_cast<int>(std::round(holeOffset.y));
+        }
+        glDrawElements(GL_TRIANGLES, m_sectionCounts[section], GL_UNSIGNED_INT, m_sectionOffsets[section]);
+
+        innerCenter = center;
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace WaterTown {
+
+class Shader;
+
+/**
+ * @brief 跟随相机的嵌套 LOD 水面网格（clipmap）
+ *
+ * 所有层共用一份 gridSize x gridSize 格的网格（顶点为格点编号），第 0 层画满整块，
+ * 之后每层间距翻倍、只画挖去内层后的环。各层中心对齐到本层间距的 2 倍，
+ * 因此内层边界总落在外层格点上，挖洞位置只有 4 种，预先生成 4 组环形索引。
+ * 每层外缘附近在 water.vert 中把奇数格点逐渐并到相邻偶数格点（geomorphing），
+ * 到边界时与外层网格完全一致，既无裂缝也无跳变。
+ */
+class WaterClipmap {
+public:
+    WaterClipmap();
+    ~WaterClipmap();
+
+    // 禁止拷贝
+    WaterClipmap(const WaterClipmap&) = delete;
+    WaterClipmap& operator=(const WaterClipmap&) = delete;
+
+    /**
+     * @brief 生成网格
+     * @param gridSize 每层每边的格子数（4 的倍数）
+     * @param baseSpacing 第 0 层的格子间距（世界坐标）
+     * @param coverage 最外层至少要覆盖的边长（世界坐标），据此决定层数
+     */
+    void build(int gridSize, float baseSpacing, float coverage);
+
+    /**
+     * @brief 逐层设置 uClipmap* uniform 并绘制（调用方负责着色器其余参数与混合状态）
+     * @param shader 水面着色器（已 use）
+     * @param focus 各层围绕的中心 XZ（通常为相机位置）
+     */
+    void draw(Shader* shader, const glm::vec2& focus);
+
+    int getLevelCount() const { return m_levelCount; }
+    int getGridSize() const { return m_gridSize; }
+    float getBaseSpacing() const { return m_baseSpacing; }
+
+    /**
+     * @brief 所有层合计的三角形数
+     */
+    int getTriangleCount() const;
+
+private:
+    unsigned int m_VAO, m_VBO, m_EBO;
+    int m_gridSize;
+    float m_baseSpacing;
+    int m_levelCount;
+
+    // 索引缓冲分段：[0] 整块网格，[1 + holeX + 2 * holeZ] 挖洞偏移为 (holeX, holeZ) 的环
+    GLsizei m_sectionCounts[5];
+    const void* m_sectionOffsets[5];
+};
+
+} // namespace WaterTown
@@ -0,0 +1,371 @@
+#include "WaterMeshBuilder.h"
+#include "../Editor/SceneEditor.h"
+#include <algorithm>
+
+namespace WaterTown {
+
+namespace {
+
+const float UV_SCALE = 0.1f; // 与逐格网格一致的 UV 缩放
+
+/**
+ * @brief 贪心合并得到的矩形（全局格子坐标）
+ */
+struct CellRect {
+    int x, z;
+    int width, depth;
+};
+
+/**
+ * @brief 把 [x0, x0 + width) x [z0, z0 + depth) 内的水格子合并为矩形（先沿 X 延伸，再沿 Z 延伸）
+ * @param open 临时缓冲（复用以减少分配）
+ */
+void mergeWaterRects(const TerrainMap& map, int x0, int z0, int width, int depth,
+                     std::vector<unsigned char>& open, std::vector<CellRect>& outRects) {
+    outRects.clear();
+    if (width <= 0 || depth <= 0) return;
+
+    open.assign(width * depth, 0);
+    bool anyWater = false;
+    for (int z = 0; z < depth; ++z) {
+        for (int x = 0; x < width; ++x) {
+            if (map.get(x0 + x, z0 + z) == TerrainType::WATER) {
+                open[z * width + x] = 1;
+                anyWater = true;
+            }
+        }
+    }
+    if (!anyWater) return;
+
+    for (int z = 0; z < depth; ++z) {
+        for (int x = 0; x < width; ) {
+            if (!open[z * width + x]) {
+                ++x;
+                continue;
+            }
+
+            int runWidth = 1;
+            while (x + runWidth < width && open[z * width + x + runWidth]) {
+                ++runWidth;
+            }
+            int runDepth = 1;
+            while (z + runDepth < depth) {
+                const unsigned char* row = &open[(z + runDepth) * width + x];
+                if (std::find(row, row + runWidth, 0) != row + runWidth) break;
+                ++runDepth;
+            }
+            for (int dz = 0; dz < runDepth; ++dz) {
+                std::fill_n(&open[(z + dz) * width + x], runWidth, 0);
+            }
+
+            outRects.push_back({x0 + x, z0 + z, runWidth, runDepth});
+            x += runWidth;
+        }
+    }
+}
+
+/**
+ * @brief 在一片格点范围内把矩形输出为共享顶点的索引网格
+ *
+ * 先用 addCorners/addSplitPoint 登记所有会成为顶点的格点，再逐个 emitRect。
+ * 矩形的边在落在它上面的每个登记格点处拆开：water.vert 对每个顶点做非线性位移，
+ * 别的矩形的角点若停在这条边中间（T 型接缝），位移后就会裂开。
+ * 边上没有多余格点的矩形仍是两个三角形，否则加一个中心顶点按扇形三角化。
+ */
+class LatticeMesh {
+public:
+    /**
+     * @param originX 范围起点格点 X（全局）
+     * @param originZ 范围起点格点 Z（全局）
+     * @param cells 范围边长（格子数），格点为 (cells + 1)^2 个
+     * @param gridSize 地形网格边长（用于计算世界坐标原点）
+     * @param cellSize 格子边长（世界坐标）
+     */
+    LatticeMesh(int originX, int originZ, int cells, int gridSize, float cellSize,
+                std::vector<float>& outVertices, std::vector<unsigned int>& outIndices)
+        : m_originX(originX), m_originZ(originZ), m_latticeSize(cells + 1),
+          m_halfSize(gridSize / 2.0f), m_cellSize(cellSize),
+          m_splitPoints(m_latticeSize * m_latticeSize, 0),
+          m_vertexIndex(m_latticeSize * m_latticeSize, -1),
+          m_vertices(outVertices), m_indices(outIndices) {
+    }
+
+    /**
+     * @brief 登记一个格点（全局坐标，范围外的忽略）
+     */
+    void addSplitPoint(int gx, int gz) {
+        int lx = gx - m_originX;
+        int lz = gz - m_originZ;
+        if (lx < 0 || lz < 0 || lx >= m_latticeSize || lz >= m_latticeSize) return;
+        m_splitPoints[lz * m_latticeSize + lx] = 1;
+    }
+
+    void addCorners(const CellRect& rect) {
+        addSplitPoint(rect.x, rect.z);
+        addSplitPoint(rect.x + rect.width, rect.z);
+        addSplitPoint(rect.x, rect.z + rect.depth);
+        addSplitPoint(rect.x + rect.width, rect.z + rect.depth);
+    }
+
+    /**
+     * @brief 输出一个矩形（角点须已登记）
+     */
+    void emitRect(const CellRect& rect) {
+        const int x1 = rect.x + rect.width;
+        const int z1 = rect.z + rect.depth;
+
+        // 沿边界走一圈：左边 +Z、下边 +X、右边 -Z、上边 -X，与规则网格的绕序一致
+        m_boundary.clear();
+        for (int z = rect.z; z < z1; ++z) addBoundaryPoint(rect.x, z);
+        for (int x = rect.x; x < x1; ++x) addBoundaryPoint(x, z1);
+        for (int z = z1; z > rect.z; --z) addBoundaryPoint(x1, z);
+        for (int x = x1; x > rect.x; --x) addBoundaryPoint(x, rect.z);
+
+        if (m_boundary.size() == 4) {
+            unsigned int v00 = m_boundary[0];
+            unsigned int v01 = m_boundary[1];
+            unsigned int v11 = m_boundary[2];
+            unsigned int v10 = m_boundary[3];
+            m_indices.push_back(v00);
+            m_indices.push_back(v01);
+            m_indices.push_back(v10);
+            m_indices.push_back(v10);
+            m_indices.push_back(v01);
+            m_indices.push_back(v11);
+            return;
+        }
+
+        unsigned int center = addVertex(rect.x + rect.width * 0.5f, rect.z + rect.depth * 0.5f);
+        for (size_t i = 0; i < m_boundary.size(); ++i) {
+            m_indices.push_back(center);
+            m_indices.push_back(m_boundary[i]);
+            m_indices.push_back(m_boundary[(i + 1) % m_boundary.size()]);
+        }
+    }
+
+private:
+    int m_originX, m_originZ;
+    int m_latticeSize;
+    float m_halfSize;
+    float m_cellSize;
+    std::vector<unsigned char> m_splitPoints;
+    std::vector<int> m_vertexIndex;          // 格点 -> 顶点索引，-1 表示尚未生成
+    std::vector<unsigned int> m_boundary;    // emitRect 的临时缓冲
+    std::vector<float>& m_vertices;
+    std::vector<unsigned int>& m_indices;
+
+    void addBoundaryPoint(int gx, int gz) {
+        int local = (gz - m_originZ) * m_latticeSize + (gx - m_originX);
+        if (!m_splitPoints[local]) return;
+        int& index = m_vertexIndex[local];
+        if (index < 0) {
+            index = static_cast<int>(addVertex(static_cast<float>(gx), static_cast<float>(gz)));
+        }
+        m_boundary.push_back(static_cast<unsigned int>(index));
+    }
+
+    unsigned int addVertex(float gx, float gz) {
+        float x = (gx - m_halfSize) * m_cellSize;
+        float z = (gz - m_halfSize) * m_cellSize;
+        m_vertices.push_back(x);
+        m_vertices.push_back(0.0f);
+        m_vertices.push_back(z);
+        m_vertices.push_back(x * UV_SCALE);
+        m_vertices.push_back(z * UV_SCALE);
+        return static_cast<unsigned int>(m_vertices.size() / 5 - 1);
+    }
+};
+
+} // namespace
+
+void WaterMeshBuilder::buildCellMesh(const TerrainMap& map, float cellSize, std::vector<float>& outVertices) {
+    outVertices.clear();
+
+    float halfSize = map.getSize() / 2.0f;
+    float uvScale = 0.1f; // UV 缩放因子
+    
+    // 按行扫描水的位平面，只访问置位的格子
+    const int wordsPerRow = map.getWordsPerRow();
+    outVertices.reserve(map.count(TerrainType::WATER) * 30);
+    for (int z = 0; z < map.getSize(); ++z) {
+        const uint64_t* waterRow = map.getRow(TerrainType::WATER, z);
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t bits = waterRow[w];
+            while (bits) {
+                int x = w * 64 + TerrainMap::lowestBit(bits);
+                bits &= bits - 1;
+
+                float x0 = (x - halfSize) * cellSize;
+                float z0 = (z - halfSize) * cellSize;
+                float x1 = x0 + cellSize;
+                float z1 = z0 + cellSize;
+                float y = 0.0f; // Base level
+                
+                // Triangle 1
+                // Vertex 0 (x0, z0)
+                outVertices.push_back(x0); outVertices.push_back(y); outVertices.push_back(z0);
+                outVertices.push_back(x0 * uvScale); outVertices.push_back(z0 * uvScale);
+                
+                // Vertex 1 (x0, z1)
+                outVertices.push_back(x0); outVertices.push_back(y); outVertices.push_back(z1);
+                outVertices.push_back(x0 * uvScale); outVertices.push_back(z1 * uvScale);
+                
+                // Vertex 2 (x1, z0)
+                outVertices.push_back(x1); outVertices.push_back(y); outVertices.push_back(z0);
+                outVertices.push_back(x1 * uvScale); outVertices.push_back(z0 * uvScale);
+                
+                // Triangle 2
+                // Vertex 3 (x1, z0)
+                outVertices.push_back(x1); outVertices.push_back(y); outVertices.push_back(z0);
+                outVertices.push_back(x1 * uvScale); outVertices.push_back(z0 * uvScale);
+                
+                // Vertex 4 (x0, z1)
+                outVertices.push_back(x0); outVertices.push_back(y); outVertices.push_back(z1);
+                outVertices.push_back(x0 * uvScale); outVertices.push_back(z1 * uvScale);
+                
+                // Vertex 5 (x1, z1)
+                outVertices.push_back(x1); outVertices.push_back(y); outVertices.push_back(z1);
+                outVertices.push_back(x1 * uvScale); outVertices.push_back(z1 * uvScale);
+            }
+        }
+    }
+}
+
+void WaterMeshBuilder::buildMergedMesh(const TerrainMap& map, float cellSize, float maxSpacing,
+                                       std::vector<float>& outVertices, std::vector<unsigned int>& outIndices) {
+    outVertices.clear();
+    outIndices.clear();
+
+    const int size = map.getSize();
+    const int step = getTileCells(cellSize, maxSpacing);
+
+    // 逐块合并，矩形不跨越块边界，因此不超过顶点最大间距
+    std::vector<CellRect> rects;
+    std::vector<CellRect> blockRects;
+    std::vector<unsigned char> open;
+    for (int z0 = 0; z0 < size; z0 += step) {
+        for (int x0 = 0; x0 < size; x0 += step) {
+            mergeWaterRects(map, x0, z0, std::min(step, size - x0), std::min(step, size - z0), open, blockRects);
+            rects.insert(rects.end(), blockRects.begin(), blockRects.end());
+        }
+    }
+
+    // 先登记所有角点，再输出，相邻矩形在公共边上共享顶点
+    LatticeMesh mesh(0, 0, size, size, cellSize, outVertices, outIndices);
+    for (const CellRect& rect : rects) {
+        mesh.addCorners(rect);
+    }
+    for (const CellRect& rect : rects) {
+        mesh.emitRect(rect);
+    }
+}
+
+int WaterMeshBuilder::getTileCells(float cellSize, float maxSpacing) {
+    return std::max(1, static_cast<int>(maxSpacing / cellSize));
+}
+
+void WaterMeshBuilder::buildTileMesh(const TerrainMap& map, int tileX, int tileZ, int tileCells, float cellSize,
+                                     std::vector<float>& outVertices, std::vector<unsigned int>& outIndices) {
+    outVertices.clear();
+    outIndices.clear();
+
+    // 分块在网格边缘时可能不满
+    const int size = map.getSize();
+    std::vector<unsigned char> open;
+    auto mergeTile = [&](int tx, int tz, std::vector<CellRect>& out) {
+        int x0 = tx * tileCells;
+        int z0 = tz * tileCells;
+        mergeWaterRects(map, x0, z0, std::min(tileCells, size - x0), std::min(tileCells, size - z0), open, out);
+    };
+
+    std::vector<CellRect> rects;
+    mergeTile(tileX, tileZ, rects);
+    if (rects.empty()) return;
+
+    LatticeMesh mesh(tileX * tileCells, tileZ * tileCells, tileCells, size, cellSize, outVertices, outIndices);
+    for (const CellRect& rect : rects) {
+        mesh.addCorners(rect);
+    }
+
+    // 相邻分块落在公共边上的角点也要拆开（其余角点在本块格点范围外，自动忽略）
+    const int neighbours[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    std::vector<CellRect> neighbourRects;
+    for (const auto& offset : neighbours) {
+        int nx = tileX + offset[0];
+        int nz = tileZ + offset[1];
+        if (nx < 0 || nz < 0 || nx * tileCells >= size || nz * tileCells >= size) continue;
+        mergeTile(nx, nz, neighbourRects);
+        for (const CellRect& rect : neighbourRects) {
+            mesh.addCorners(rect);
+        }
+    }
+
+    for (const CellRect& rect : rects) {
+        mesh.emitRect(rect);
+    }
+}
+
+void WaterMeshBuilder::buildWaterMask(const TerrainMap& map, std::vector<unsigned char>& outMask) {
+    const int size = map.getSize();
+    const int wordsPerRow = map.getWordsPerRow();
+    outMask.assign(size * size, 0);
+
+    for (int z = 0; z < size; ++z) {
+        const uint64_t* waterRow = map.getRow(TerrainType::WATER, z);
+        unsigned char* maskRow = &outMask[z * size];
+        for (int w = 0; w < wordsPerRow; ++w) {
+            uint64_t bits = waterRow[w];
+            while (bits) {
+                maskRow[w * 64 + TerrainMap::lowestBit(bits)] = 255;
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+int WaterMeshBuilder::labelWaterRegions(const TerrainMap& map, std::vector<int>& outLabels,
+                                        std::vector<WaterRegionInfo>& outRegions) {
+    const int size = map.getSize();
+    outLabels.assign(size * size, 0);
+    outRegions.clear();
+
+    // 逐行扫描，遇到未标记的水格子就从它出发做一次深度优先填充
+    std::vector<int> stack;
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            if (outLabels[z * size + x] != 0 || map.get(x, z) != TerrainType::WATER) continue;
+
+            const int label = static_cast<int>(outRegions.size()) + 1;
+            WaterRegionInfo info = {0, x, z, x, z};
+            outLabels[z * size + x] = label;
+            stack.push_back(z * size + x);
+            while (!stack.empty()) {
+                int cell = stack.back();
+                stack.pop_back();
+                int cx = cell % size;
+                int cz = cell / size;
+                ++info.cellCount;
+                info.minX = std::min(info.minX, cx);
+                info.maxX = std::max(info.maxX, cx);
+                info.minZ = std::min(info.minZ, cz);
+                info.maxZ = std::max(info.maxZ, cz);
+
+                for (int dz = -1; dz <= 1; ++dz) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int nx = cx + dx;
+                        int nz = cz + dz;
+                        if (nx < 0 || nz < 0 || nx >= size || nz >= size) continue;
+                        int neighbour = nz * size + nx;
+                        if (outLabels[neighbour] != 0 || map.get(nx, nz) != TerrainType::WATER) continue;
+                        outLabels[neighbour] = label;
+                        stack.push_back(neighbour);
+                    }
+                }
+            }
+            outRegions.push_back(info);
+        }
+    }
+    return static_cast<int>(outRegions.size());
+}
+
+} // namespace WaterTown
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+namespace WaterTown {
+
+class TerrainMap;
+
+/**
+ * @brief 一块连通水域的统计信息（格子坐标，包围盒为闭区间）
+ */
+struct WaterRegionInfo {
+    int cellCount;
+    int minX, minZ;
+    int maxX, maxZ;
+};
+
+/**
+ * @brief 水面网格/遮罩生成（纯 CPU，不依赖 OpenGL），结果交给 WaterSurface 上传
+ */
+class WaterMeshBuilder {
+public:
+    /**
+     * @brief 为每个 WATER 格子生成两个三角形
+     * @param map 地形网格
+     * @param cellSize 格子边长（世界坐标）
+     * @param outVertices 输出顶点，每顶点 5 个 float（x, y, z, u, v）
+     */
+    static void buildCellMesh(const TerrainMap& map, float cellSize, std::vector<float>& outVertices);
+    
+    /**
+     * @brief 将水格子合并为最大矩形并生成共享顶点的索引网格
+     *
+     * 按 step x step 格的块（step = floor(maxSpacing / cellSize)）分别合并，矩形不跨块，边长不超过 maxSpacing。
+     * 顶点按格点坐标去重共享；每个矩形的边在所有落在其上的其他矩形角点处拆开（此时加中心顶点按扇形三角化），
+     * 因此没有 T 型接缝，顶点位移后网格不会裂开。
+     * @param map 地形网格
+     * @param cellSize 格子边长（世界坐标）
+     * @param maxSpacing 顶点最大间距（由波浪位移所需的采样密度决定）
+     * @param outVertices 输出顶点，每顶点 5 个 float（x, y, z, u, v）
+     * @param outIndices 输出三角形索引
+     */
+    static void buildMergedMesh(const TerrainMap& map, float cellSize, float maxSpacing,
+                                std::vector<float>& outVertices, std::vector<unsigned int>& outIndices);
+    
+    /**
+     * @brief 分块边长（格子数）：不超过波浪位移所需的顶点间距，块内矩形无需再细分
+     */
+    static int getTileCells(float cellSize, float maxSpacing);
+    
+    /**
+     * @brief 生成一个分块的水面网格，只包含矩形实际引用的顶点
+     *
+     * 与 buildMergedMesh 相同的合并与拆边方式；分块边界上还在相邻分块的矩形角点处拆开，
+     * 因此某个分块的水格子变化后，它的四个相邻分块也要重建。
+     * @param map 地形网格
+     * @param tileX 分块 X 坐标（以分块为单位）
+     * @param tileZ 分块 Z 坐标（以分块为单位）
+     * @param tileCells 分块边长（格子数）
+     * @param cellSize 格子边长（世界坐标）
+     * @param outVertices 输出顶点，每顶点 5 个 float（x, y, z, u, v），分块内没有水时为空
+     * @param outIndices 输出三角形索引（相对分块首顶点）
+     */
+    static void buildTileMesh(const TerrainMap& map, int tileX, int tileZ, int tileCells, float cellSize,
+                              std::vector<float>& outVertices, std::vector<unsigned int>& outIndices);
+    
+    /**
+     * @brief 生成逐格水域遮罩（供 WaterSurface::setWaterMask 上传）
+     * @param map 地形网格
+     * @param outMask 输出，size*size 字节，按 z * size + x 排列，水为 255，其余为 0
+     */
+    static void buildWaterMask(const TerrainMap& map, std::vector<unsigned char>& outMask);
+    
+    /**
+     * @brief 对 WATER 格子做连通区域标记（8 邻接，只在对角相接的两块水也算同一块，
+     *        保证任一格点周围的水格子都属于同一区域）
+     * @param map 地形网格
+     * @param outLabels 输出，size*size 个，按 z * size + x 排列，非水为 0，水为区域编号 + 1
+     * @param outRegions 输出每个区域的格子数与包围盒，下标为区域编号（按首次扫描到的顺序）
+     * @return 区域数量
+     */
+    static int labelWaterRegions(const TerrainMap& map, std::vector<int>& outLabels,
+                                 std::vector<WaterRegionInfo>& outRegions);
+};
+
+} // namespace WaterTown
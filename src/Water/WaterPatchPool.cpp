@@ -0,0 +1,195 @@
+#include "WaterPatchPool.h"
+#include "../Render/RenderState.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace WaterTown {
+
+namespace {
+
+/**
+ * @brief 能容纳 count 个元素的最小级别（容量 1 << level）
+ */
+int rangeLevel(int count) {
+    int level = 0;
+    while ((1 << level) < count) {
+        ++level;
+    }
+    return level;
+}
+
+} // namespace
+
+void WaterPatchPool::RangeAllocator::reset() {
+    m_size = 0;
+    m_freeLists.clear();
+}
+
+WaterPatchPool::Range WaterPatchPool::RangeAllocator::allocate(int count) {
+    if (count <= 0) return {0, 0};
+
+    int level = rangeLevel(count);
+    if (level < static_cast<int>(m_freeLists.size()) && !m_freeLists[level].empty()) {
+        int first = m_freeLists[level].back();
+        m_freeLists[level].pop_back();
+        return {first, 1 << level};
+    }
+    Range range = {m_size, 1 << level};
+    m_size += range.capacity;
+    return range;
+}
+
+void WaterPatchPool::RangeAllocator::release(const Range& range) {
+    if (range.capacity <= 0) return;
+    int level = rangeLevel(range.capacity);
+    if (level >= static_cast<int>(m_freeLists.size())) {
+        m_freeLists.resize(level + 1);
+    }
+    m_freeLists[level].push_back(range.first);
+}
+
+WaterPatchPool::WaterPatchPool()
+    : m_VAO(0), m_VBO(0), m_EBO(0), m_needsFullUpload(false) {
+}
+
+WaterPatchPool::~WaterPatchPool() {
+    if (m_VAO) RenderState::deleteVertexArrays(1, &m_VAO);
+    if (m_VBO) RenderState::deleteBuffers(1, &m_VBO);
+    if (m_EBO) RenderState::deleteBuffers(1, &m_EBO);
+}
+
+void WaterPatchPool::reset(int initialVertexCapacity, int initialIndexCapacity) {
+    m_vertexRanges.reset();
+    m_indexRanges.reset();
+    m_vertices.assign(static_cast<size_t>(std::max(1, initialVertexCapacity)) * 5, 0.0f);
+    m_indices.assign(std::max(1, initialIndexCapacity), 0);
+    m_patches.clear();
+    m_freePatches.clear();
+    m_drawCounts.clear();
+    m_drawOffsets.clear();
+    m_needsFullUpload = true;
+}
+
+void WaterPatchPool::ensureCapacity() {
+    const size_t vertexFloats = static_cast<size_t>(m_vertexRanges.getSize()) * 5;
+    if (vertexFloats > m_vertices.size()) {
+        m_vertices.resize(std::max(vertexFloats, m_vertices.size() * 2), 0.0f);
+        m_needsFullUpload = true;
+    }
+    const size_t indexCount = static_cast<size_t>(m_indexRanges.getSize());
+    if (indexCount > m_indices.size()) {
+        m_indices.resize(std::max(indexCount, m_indices.size() * 2), 0);
+        m_needsFullUpload = true;
+    }
+}
+
+int WaterPatchPool::allocate() {
+    if (!m_freePatches.empty()) {
+        int patch = m_freePatches.back();
+        m_freePatches.pop_back();
+        return patch;
+    }
+    m_patches.push_back({{0, 0}, {0, 0}});
+    m_drawCounts.push_back(0);
+    m_drawOffsets.push_back(nullptr);
+    return static_cast<int>(m_patches.size()) - 1;
+}
+
+void WaterPatchPool::release(int patch) {
+    if (patch < 0 || patch >= static_cast<int>(m_patches.size())) return;
+    Patch& p = m_patches[patch];
+    m_vertexRanges.release(p.vertices);
+    m_indexRanges.release(p.indices);
+    p.vertices = {0, 0};
+    p.indices = {0, 0};
+    m_drawCounts[patch] = 0;
+    m_freePatches.push_back(patch);
+}
+
+void WaterPatchPool::write(int patch, const std::vector<float>& vertices, const std::vector<unsigned int>& localIndices) {
+    if (patch < 0 || patch >= static_cast<int>(m_patches.size())) return;
+    Patch& p = m_patches[patch];
+    const int vertexCount = static_cast<int>(vertices.size() / 5);
+    const int indexCount = static_cast<int>(localIndices.size());
+
+    // 放不下时换区间；变小时保留原区间，下次变大不必再换
+    if (vertexCount > p.vertices.capacity) {
+        m_vertexRanges.release(p.vertices);
+        p.vertices = m_vertexRanges.allocate(vertexCount);
+    }
+    if (indexCount > p.indices.capacity) {
+        m_indexRanges.release(p.indices);
+        p.indices = m_indexRanges.allocate(indexCount);
+    }
+    ensureCapacity();
+
+    const size_t firstFloat = static_cast<size_t>(p.vertices.first) * 5;
+    std::copy(vertices.begin(), vertices.begin() + static_cast<size_t>(vertexCount) * 5, m_vertices.begin() + firstFloat);
+
+    const size_t firstIndex = static_cast<size_t>(p.indices.first);
+    const unsigned int baseVertex = static_cast<unsigned int>(p.vertices.first);
+    for (int i = 0; i < indexCount; ++i) {
+        m_indices[firstIndex + i] = baseVertex + localIndices[i];
+    }
+    m_drawCounts[patch] = indexCount;
+    m_drawOffsets[patch] = reinterpret_cast<const void*>(
+        static_cast<uintptr_t>(firstIndex * sizeof(unsigned int)));
+
+    if (!m_needsFullUpload) {
+        if (vertexCount > 0) {
+            RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+            glBufferSubData(GL_ARRAY_BUFFER, firstFloat * sizeof(float),
+                            vertexCount * 5 * sizeof(float), &m_vertices[firstFloat]);
+            RenderState::bindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        if (indexCount > 0) {
+            // 索引缓冲绑定属于 VAO 状态，通过 VAO 更新
+            RenderState::bindVertexArray(m_VAO);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstIndex * sizeof(unsigned int),
+                            indexCount * sizeof(unsigned int), &m_indices[firstIndex]);
+            RenderState::bindVertexArray(0);
+        }
+    }
+}
+
+void WaterPatchPool::draw() {
+    if (m_patches.empty()) return;
+
+    if (m_VAO == 0) {
+        glGenVertexArrays(1, &m_VAO);
+        glGenBuffers(1, &m_VBO);
+        glGenBuffers(1, &m_EBO);
+
+        RenderState::bindVertexArray(m_VAO);
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        RenderState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+        // 位置属性
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        // UV 属性
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+
+        RenderState::bindVertexArray(0);
+        m_needsFullUpload = true;
+    }
+
+    // 重置/扩容后整体上传一次，之后只做局部更新
+    if (m_needsFullUpload) {
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(float), m_vertices.data(), GL_DYNAMIC_DRAW);
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+        RenderState::bindVertexArray(m_VAO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(unsigned int), m_indices.data(), GL_DYNAMIC_DRAW);
+        m_needsFullUpload = false;
+    }
+
+    RenderState::bindVertexArray(m_VAO);
+    glMultiDrawElements(GL_TRIANGLES, m_drawCounts.data(), GL_UNSIGNED_INT, m_drawOffsets.data(),
+                        static_cast<GLsizei>(m_patches.size()));
+}
+
+} // namespace WaterTown
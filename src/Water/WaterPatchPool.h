@@ -0,0 +1,103 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 预分配的水面分块缓冲：每块按实际顶点/索引数占用一段区间，编辑时只用 glBufferSubData 改写对应区间
+ *
+ * 区间容量取 2 的幂，归还的区间按容量进入空闲链表复用；缓冲用尽时容量翻倍（唯一一次整缓冲重新分配）。
+ * 绘制时用 glMultiDrawElements 一次提交所有分块。
+ */
+class WaterPatchPool {
+public:
+    WaterPatchPool();
+    ~WaterPatchPool();
+
+    // 禁止拷贝
+    WaterPatchPool(const WaterPatchPool&) = delete;
+    WaterPatchPool& operator=(const WaterPatchPool&) = delete;
+
+    /**
+     * @brief 清空所有分块并重新预分配缓冲
+     * @param initialVertexCapacity 预分配的顶点数（每顶点 5 个 float：x, y, z, u, v）
+     * @param initialIndexCapacity 预分配的索引数
+     */
+    void reset(int initialVertexCapacity, int initialIndexCapacity);
+
+    /**
+     * @brief 分配一个分块编号（初始不占用区间，不绘制任何东西）
+     */
+    int allocate();
+
+    /**
+     * @brief 归还分块及其区间，之后不再绘制
+     */
+    void release(int patch);
+
+    /**
+     * @brief 写入分块的顶点与索引，现有区间放不下时换一段更大的区间
+     * @param vertices 每顶点 5 个 float
+     * @param localIndices 相对分块首顶点的索引（写入时加上区间偏移）
+     */
+    void write(int patch, const std::vector<float>& vertices, const std::vector<unsigned int>& localIndices);
+
+    /**
+     * @brief 绘制所有已分配分块（调用方负责着色器与混合状态）
+     */
+    void draw();
+
+    int getActiveCount() const { return static_cast<int>(m_patches.size() - m_freePatches.size()); }
+
+private:
+    /**
+     * @brief 缓冲中的一段区间（以元素计，capacity 为 0 或 2 的幂）
+     */
+    struct Range {
+        int first;
+        int capacity;
+    };
+
+    /**
+     * @brief 按 2 的幂分级的区间分配器，只分配下标，数据由 WaterPatchPool 保存
+     */
+    class RangeAllocator {
+    public:
+        void reset();
+        Range allocate(int count);
+        void release(const Range& range);
+        int getSize() const { return m_size; }
+
+    private:
+        int m_size = 0;                              // 已划出的元素数，新区间从末尾划出
+        std::vector<std::vector<int>> m_freeLists;   // 按级别（log2 容量）的空闲区间起点
+    };
+
+    struct Patch {
+        Range vertices;
+        Range indices;
+    };
+
+    unsigned int m_VAO, m_VBO, m_EBO;
+    RangeAllocator m_vertexRanges;
+    RangeAllocator m_indexRanges;
+
+    // CPU 端副本，扩容或重置后整体上传一次
+    std::vector<float> m_vertices;
+    std::vector<unsigned int> m_indices;
+    bool m_needsFullUpload;
+
+    std::vector<Patch> m_patches;
+    std::vector<int> m_freePatches;         // 空闲分块编号（栈）
+    std::vector<GLsizei> m_drawCounts;      // 每分块的索引数，空闲分块为 0
+    std::vector<const void*> m_drawOffsets; // 每分块在索引缓冲中的字节偏移
+
+    /**
+     * @brief 区间分配超出 CPU 副本时把副本扩到至少两倍，之后整体上传
+     */
+    void ensureCapacity();
+};
+
+} // namespace WaterTown
@@ -1,9 +1,12 @@
 #include "WaterSurface.h"
 #include "../Render/Shader.h"
 #include "../Render/Camera.h"
+#include "../Render/RenderState.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 
 namespace WaterTown {
@@ -11,7 +14,14 @@ namespace WaterTown {
 WaterSurface::WaterSurface(float centerX, float centerZ, float width, float height, int resolution)
     : m_centerX(centerX), m_centerZ(centerZ), m_width(width), m_height(height),
       m_baseHeight(0.0f), m_resolution(resolution), m_VAO(0), m_VBO(0), m_EBO(0),
-      m_vertexCount(0), m_indexCount(0), m_useCustomMesh(false) {
+      m_vertexCount(0), m_indexCount(0), m_useCustomMesh(false), m_customIndexed(false), m_usePatchPool(false),
+      m_clipmapEnabled(false), m_maskTexture(0), m_maskGridSize(0), m_maskCellSize(1.0f), m_maskOrigin(0.0f),
+      m_regionTexture(0), m_regionGridSize(0), m_regionCellSize(1.0f), m_regionOrigin(0.0f),
+      m_paramsUBO(0), m_paramsProgram(0), m_wavesDirty(true),
+      m_wakeEnabled(false), m_wake(nullptr), m_wakeTexture(0),
+      m_waveModel(WaveModel::GERSTNER), m_ocean(nullptr),
+      m_oceanDisplacementTexture(0), m_oceanNormalTexture(0),
+      m_heightfieldEnabled(false) {
     
     // 初始化默认波浪参数（4 个不同方向的波浪）
     m_waves.push_back({glm::vec2(1.0f, 0.0f), 0.15f, 2.0f, 1.0f, 0.3f});
@@ -19,6 +29,10 @@ WaterSurface::WaterSurface(float centerX, float centerZ, float width, float heig
     m_waves.push_back({glm::vec2(0.0f, 1.0f), 0.08f, 1.0f, 0.8f, 0.25f});
     m_waves.push_back({glm::vec2(-0.5f, 0.5f), 0.05f, 0.8f, 1.5f, 0.15f});
     
+    static_assert(sizeof(ParamsBlock) == MAX_WAVE_SETS * 4 * 32 + 144,
+                  "ParamsBlock must match the std140 layout of WaterParams");
+    std::memset(&m_params, 0, sizeof(m_params));
+    
     generateMesh();
     
     std::cout << "WaterSurface created: " << m_vertexCount << " vertices, " 
@@ -26,27 +40,173 @@ WaterSurface::WaterSurface(float centerX, float centerZ, float width, float heig
 }
 
 WaterSurface::~WaterSurface() {
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_EBO) glDeleteBuffers(1, &m_EBO);
+    if (m_VAO) RenderState::deleteVertexArrays(1, &m_VAO);
+    if (m_VBO) RenderState::deleteBuffers(1, &m_VBO);
+    if (m_EBO) RenderState::deleteBuffers(1, &m_EBO);
+    if (m_maskTexture) glDeleteTextures(1, &m_maskTexture);
+    if (m_paramsUBO) RenderState::deleteBuffers(1, &m_paramsUBO);
+    if (m_oceanDisplacementTexture) glDeleteTextures(1, &m_oceanDisplacementTexture);
+    if (m_oceanNormalTexture) glDeleteTextures(1, &m_oceanNormalTexture);
+    if (m_wakeTexture) glDeleteTextures(1, &m_wakeTexture);
+    if (m_regionTexture) glDeleteTextures(1, &m_regionTexture);
+    delete m_ocean;
+    delete m_wake;
+}
+
+void WaterSurface::setWakeEnabled(bool enabled) {
+    m_wakeEnabled = enabled;
+    if (!enabled) {
+        if (m_wake) m_wake->reset();
+        return;
+    }
+    
+    if (!m_wake) {
+        m_wake = new WakeSimulation();
+        std::cout << "WakeSimulation created: " << m_wake->getResolution() << "x" << m_wake->getResolution()
+                  << " cells, " << m_wake->getSize() << "m window" << std::endl;
+    }
+}
+
+void WaterSurface::updateWake(float deltaTime, const glm::vec2& boatPos, const glm::vec2& boatForward,
+                              float boatSpeed, float boatLength, float boatWidth) {
+    if (!m_wakeEnabled || !m_wake) return;
+    
+    // 倒车时船尾在前
+    glm::vec2 forward = (boatSpeed >= 0.0f) ? boatForward : -boatForward;
+    m_wake->setCenter(boatPos);
+    m_wake->applyHull(boatPos, forward, boatLength, boatWidth, std::fabs(boatSpeed), deltaTime);
+    m_wake->update(deltaTime);
+    
+    const int n = m_wake->getResolution();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (m_wakeTexture == 0) {
+        glGenTextures(1, &m_wakeTexture);
+        glBindTexture(GL_TEXTURE_2D, m_wakeTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, n, n, 0, GL_RED, GL_FLOAT, m_wake->getHeights().data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // 窗口以外没有尾迹：边框颜色为 0
+        float border[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, m_wakeTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, n, n, GL_RED, GL_FLOAT, m_wake->getHeights().data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void WaterSurface::setWaveModel(WaveModel model) {
+    if (model == m_waveModel) return;
+    m_waveModel = model;
+    m_heightfield.invalidate();
+    
+    if (model == WaveModel::FFT_OCEAN && !m_ocean) {
+        m_ocean = new OceanSpectrum();
+        std::cout << "OceanSpectrum created: " << m_ocean->getResolution() << "x" << m_ocean->getResolution()
+                  << " samples, " << m_ocean->getPatchSize() << "m patch" << std::endl;
+    }
+}
+
+void WaterSurface::update(float time) {
+    if (m_waveModel != WaveModel::FFT_OCEAN || !m_ocean) return;
+    
+    m_ocean->update(time);
+    uploadOceanTextures();
+}
+
+void WaterSurface::uploadOceanTextures() {
+    const int n = m_ocean->getResolution();
+    bool created = (m_oceanDisplacementTexture == 0);
+    if (created) {
+        glGenTextures(1, &m_oceanDisplacementTexture);
+        glGenTextures(1, &m_oceanNormalTexture);
+    }
+    
+    unsigned int textures[2] = {m_oceanDisplacementTexture, m_oceanNormalTexture};
+    const float* data[2] = {&m_ocean->getDisplacements()[0].x, &m_ocean->getNormals()[0].x};
+    for (int i = 0; i < 2; ++i) {
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        if (created) {
+            // 线性过滤 + 重复寻址：与 OceanSpectrum::sample 的双线性平铺采样一致
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, n, n, 0, GL_RGBA, GL_FLOAT, data[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        } else {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, n, n, GL_RGBA, GL_FLOAT, data[i]);
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void WaterSurface::setWaterMask(const std::vector<unsigned char>& mask, int gridSize, float cellSize,
+                                float originX, float originZ) {
+    if (gridSize <= 0 || mask.size() < static_cast<size_t>(gridSize * gridSize)) return;
+    
+    bool resized = (m_maskTexture == 0 || gridSize != m_maskGridSize);
+    if (m_maskTexture == 0) {
+        glGenTextures(1, &m_maskTexture);
+    }
+    
+    m_maskGridSize = gridSize;
+    m_maskCellSize = cellSize;
+    m_maskOrigin = glm::vec2(originX, originZ);
+    
+    glBindTexture(GL_TEXTURE_2D, m_maskTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (resized) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, gridSize, gridSize, 0, GL_RED, GL_UNSIGNED_BYTE, mask.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, gridSize, gridSize, GL_RED, GL_UNSIGNED_BYTE, mask.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void WaterSurface::updateMesh(const std::vector<float>& vertices) {
+void WaterSurface::setWaterMaskRegion(int gridX, int gridZ, int width, int height, const unsigned char* data) {
+    if (m_maskTexture == 0 || !data || width <= 0 || height <= 0) return;
+    if (gridX < 0 || gridZ < 0 || gridX + width > m_maskGridSize || gridZ + height > m_maskGridSize) return;
+    
+    glBindTexture(GL_TEXTURE_2D, m_maskTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, gridX, gridZ, width, height, GL_RED, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void WaterSurface::updateMesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
     m_useCustomMesh = true;
+    m_customIndexed = !indices.empty();
+    m_usePatchPool = false;
     
     if (m_VAO == 0) {
         glGenVertexArrays(1, &m_VAO);
         glGenBuffers(1, &m_VBO);
     }
     
-    glBindVertexArray(m_VAO);
+    RenderState::bindVertexArray(m_VAO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
-    // 如果使用 updateMesh，通常不再使用 EBO (glDrawArrays)
     m_vertexCount = vertices.size() / 5; // 5 floats per vertex
     
+    if (m_customIndexed) {
+        if (m_EBO == 0) {
+            glGenBuffers(1, &m_EBO);
+        }
+        RenderState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        m_indexCount = static_cast<int>(indices.size());
+    }
+    
     // 位置属性
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -55,7 +215,36 @@ void WaterSurface::updateMesh(const std::vector<float>& vertices) {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    RenderState::bindVertexArray(0);
+}
+
+void WaterSurface::usePatchPool() {
+    m_useCustomMesh = true;
+    m_customIndexed = false;
+    m_usePatchPool = true;
+}
+
+void WaterSurface::setClipmapEnabled(bool enabled, float baseSpacing, int gridSize) {
+    m_clipmapEnabled = enabled;
+    if (!enabled) return;
+    if (m_clipmap.getLevelCount() > 0 && m_clipmap.getBaseSpacing() == baseSpacing
+        && m_clipmap.getGridSize() == gridSize) {
+        return;
+    }
+    
+    // 以水面内任意位置为中心都要覆盖整个水面，最外层边长至少为水面边长的 2 倍
+    m_clipmap.build(gridSize, baseSpacing, 2.0f * std::max(m_width, m_height));
+    std::cout << "WaterClipmap built: " << m_clipmap.getLevelCount() << " levels, "
+              << m_clipmap.getTriangleCount() << " triangles (uniform grid: "
+              << m_indexCount / 3 << ")" << std::endl;
+}
+
+void WaterSurface::resetMesh() {
+    if (!m_useCustomMesh) return;
+    m_useCustomMesh = false;
+    m_customIndexed = false;
+    m_usePatchPool = false;
+    generateMesh();
 }
 
 void WaterSurface::generateMesh() {
@@ -107,17 +296,17 @@ void WaterSurface::generateMesh() {
     m_vertexCount = (m_resolution + 1) * (m_resolution + 1);
     m_indexCount = static_cast<int>(indices.size());
     
-    // 创建 VAO/VBO/EBO
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-    glGenBuffers(1, &m_EBO);
+    // 创建 VAO/VBO/EBO（resetMesh 时复用已有对象）
+    if (m_VAO == 0) glGenVertexArrays(1, &m_VAO);
+    if (m_VBO == 0) glGenBuffers(1, &m_VBO);
+    if (m_EBO == 0) glGenBuffers(1, &m_EBO);
     
-    glBindVertexArray(m_VAO);
+    RenderState::bindVertexArray(m_VAO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    RenderState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    RenderState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
     
     // 位置属性
@@ -128,7 +317,7 @@ void WaterSurface::generateMesh() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    RenderState::bindVertexArray(0);
 }
 
 void WaterSurface::render(Shader* shader,
@@ -144,90 +333,432 @@ void WaterSurface::render(Shader* shader,
     
     shader->use();
     
-    // 设置 MVP 矩阵
+    // 模型矩阵与时间（相机矩阵、相机位置来自 FrameUniforms 块）
     glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_baseHeight, 0.0f));
     shader->setMat4("uModel", model);
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    
-    // 设置时间和相机位置
     shader->setFloat("uTime", time);
-    shader->setVec3("uViewPos", camera->getPosition());
     
-    // 设置波浪参数（最多 4 个波浪）
-    int waveCount = std::min(static_cast<int>(m_waves.size()), 4);
-    shader->setInt("uWaveCount", waveCount);
+    // FFT 海浪：位移/法线纹理占用纹理单元 1、2（0 留给水域遮罩）
+    bool useOcean = (m_waveModel == WaveModel::FFT_OCEAN && m_oceanDisplacementTexture != 0);
+    shader->setInt("uWaveModel", useOcean ? 1 : 0);
+    if (useOcean) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_oceanDisplacementTexture);
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, m_oceanNormalTexture);
+        glActiveTexture(GL_TEXTURE0);
+        shader->setInt("uOceanDisplacement", 1);
+        shader->setInt("uOceanNormal", 2);
+        shader->setFloat("uOceanPatchSize", m_ocean->getPatchSize());
+    }
     
-    for (int i = 0; i < waveCount; ++i) {
-        std::string prefix = "uWaves[" + std::to_string(i) + "].";
-        shader->setVec2(prefix + "direction", m_waves[i].direction);
-        shader->setFloat(prefix + "amplitude", m_waves[i].amplitude);
-        shader->setFloat(prefix + "wavelength", m_waves[i].wavelength);
-        shader->setFloat(prefix + "speed", m_waves[i].speed);
-        shader->setFloat(prefix + "steepness", m_waves[i].steepness);
+    // 波浪、颜色、光照、船只裁剪参数（uniform 块，只有内容变化时才上传）
+    ParamsBlock params = m_params;
+    if (m_wavesDirty) {
+        // 每组最多 4 个波浪，第 0 组为默认波浪，之后依次为各水域
+        for (int set = 0; set < MAX_WAVE_SETS; ++set) {
+            int waveCount = 0;
+            const GerstnerWave* waves = getWaveSet(set, waveCount);
+            params.waveCounts[set] = waveCount;
+            for (int i = 0; i < waveCount; ++i) {
+                ParamsBlock::Wave& wave = params.waves[set * 4 + i];
+                wave.direction[0] = waves[i].direction.x;
+                wave.direction[1] = waves[i].direction.y;
+                wave.amplitude = waves[i].amplitude;
+                wave.wavelength = waves[i].wavelength;
+                wave.speed = waves[i].speed;
+                wave.steepness = waves[i].steepness;
+            }
+        }
+        m_wavesDirty = false;
+    }
+    
+    // 水域编号纹理占用纹理单元 4，顶点按所在水域选择波浪组
+    bool useRegions = (!m_regionMap.empty() && m_regionTexture != 0);
+    shader->setInt("uUseWaterRegions", useRegions ? 1 : 0);
+    if (useRegions) {
+        glActiveTexture(GL_TEXTURE4);
+        glBindTexture(GL_TEXTURE_2D, m_regionTexture);
+        glActiveTexture(GL_TEXTURE0);
+        shader->setInt("uWaterRegions", 4);
+        shader->setVec2("uRegionOrigin", m_regionOrigin);
+        shader->setFloat("uRegionCellSize", m_regionCellSize);
+        shader->setInt("uRegionGridSize", m_regionGridSize);
+    }
+    
+    // 船只尾迹：高度纹理占用纹理单元 3
+    bool useWake = (m_wakeEnabled && m_wakeTexture != 0);
+    shader->setInt("uUseWake", useWake ? 1 : 0);
+    if (useWake) {
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, m_wakeTexture);
+        glActiveTexture(GL_TEXTURE0);
+        shader->setInt("uWakeHeight", 3);
+        shader->setVec2("uWakeOrigin", m_wake->getOrigin());
+        shader->setFloat("uWakeSize", m_wake->getSize());
     }
     
     // 水面颜色参数
-    shader->setVec3("uWaterColor", glm::vec3(0.1f, 0.3f, 0.5f));  // 深蓝色
-    shader->setVec3("uLightDir", glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f)));
+    glm::vec3 waterColor(0.1f, 0.3f, 0.5f);  // 深蓝色
+    glm::vec3 lightDir = glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f));
+    std::memcpy(params.waterColor, &waterColor.x, sizeof(params.waterColor));
+    std::memcpy(params.lightDir, &lightDir.x, sizeof(params.lightDir));
 
     // 船只裁剪（避免水出现在船板上）
     bool useObb = (boatHalfExtentsXZ.x > 0.0f && boatHalfExtentsXZ.y > 0.0f && boatCutoutFeather > 0.0f);
     bool useCircle = (boatCutoutInner > 0.0f && boatCutoutOuter >= boatCutoutInner);
     bool useCutout = useObb || useCircle;
 
-    shader->setInt("uUseBoatCutout", useCutout ? 1 : 0);
-    shader->setVec3("uBoatPos", boatPos);
-    shader->setFloat("uBoatCutoutInner", boatCutoutInner);
-    shader->setFloat("uBoatCutoutOuter", boatCutoutOuter);
-    shader->setInt("uBoatCutoutShape", useObb ? 1 : 0);
-    shader->setVec2("uBoatForwardXZ", boatForwardXZ);
-    shader->setVec2("uBoatHalfExtentsXZ", boatHalfExtentsXZ);
-    shader->setFloat("uBoatCutoutFeather", boatCutoutFeather);
+    params.useBoatCutout = useCutout ? 1 : 0;
+    params.boatCutoutShape = useObb ? 1 : 0;
+    params.boatCutoutInner = boatCutoutInner;
+    params.boatCutoutOuter = boatCutoutOuter;
+    params.boatCutoutFeather = boatCutoutFeather;
+    std::memcpy(params.boatPos, &boatPos.x, sizeof(params.boatPos));
+    std::memcpy(params.boatForwardXZ, &boatForwardXZ.x, sizeof(params.boatForwardXZ));
+    std::memcpy(params.boatHalfExtentsXZ, &boatHalfExtentsXZ.x, sizeof(params.boatHalfExtentsXZ));
+    uploadParams(shader, params);
+    
+    // 逐格水域遮罩（自定义网格本身已贴合水域，不再需要遮罩）
+    bool useMask = (m_maskTexture != 0 && !m_useCustomMesh);
+    shader->setInt("uUseWaterMask", useMask ? 1 : 0);
+    if (useMask) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_maskTexture);
+        shader->setInt("uWaterMask", 0);
+        shader->setVec2("uMaskOrigin", m_maskOrigin);
+        shader->setFloat("uMaskCellSize", m_maskCellSize);
+        shader->setInt("uMaskGridSize", m_maskGridSize);
+    }
     
     // 启用混合（半透明效果）
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::enable(GL_BLEND);
+    RenderState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // 渲染水面
-    glBindVertexArray(m_VAO);
-    if (m_useCustomMesh) {
-         glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
+    bool useClipmap = (m_clipmapEnabled && !m_useCustomMesh);
+    shader->setInt("uUseClipmap", useClipmap ? 1 : 0);
+    if (useClipmap) {
+        glm::vec2 boundsMin(m_centerX - m_width / 2.0f, m_centerZ - m_height / 2.0f);
+        glm::vec2 boundsMax(m_centerX + m_width / 2.0f, m_centerZ + m_height / 2.0f);
+        shader->setVec2("uClipmapBoundsMin", boundsMin);
+        shader->setVec2("uClipmapBoundsMax", boundsMax);
+        
+        // 相机在水面外时以最近的水面点为中心，保证整个水面都被覆盖
+        glm::vec3 cameraPos = camera->getPosition();
+        glm::vec2 focus = glm::clamp(glm::vec2(cameraPos.x, cameraPos.z), boundsMin, boundsMax);
+        m_clipmap.draw(shader, focus);
+    } else if (m_usePatchPool) {
+        m_patchPool.draw();
     } else {
-         glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
+        RenderState::bindVertexArray(m_VAO);
+        if (m_useCustomMesh && !m_customIndexed) {
+             glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
+        } else {
+             glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
+        }
+    }
+    if (useMask) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    if (useOcean) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    if (useWake) {
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    if (useRegions) {
+        glActiveTexture(GL_TEXTURE4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glActiveTexture(GL_TEXTURE0);
     }
-    glBindVertexArray(0);
     
-    glDisable(GL_BLEND);
+    RenderState::disable(GL_BLEND);
 }
 
-float WaterSurface::getWaterHeight(float x, float z, float time) const {
-    return m_baseHeight + calculateGerstnerHeight(x, z, time);
+void WaterSurface::uploadParams(Shader* shader, const ParamsBlock& params) {
+    if (m_paramsUBO == 0) {
+        glGenBuffers(1, &m_paramsUBO);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, m_paramsUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(ParamsBlock), &params, GL_DYNAMIC_DRAW);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_params = params;
+    } else if (std::memcmp(&params, &m_params, sizeof(ParamsBlock)) != 0) {
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, m_paramsUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ParamsBlock), &params);
+        RenderState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_params = params;
+    }
+    
+    // 块绑定属于程序对象状态，每个着色器只需设置一次
+    if (m_paramsProgram != shader->getID()) {
+        unsigned int blockIndex = glGetUniformBlockIndex(shader->getID(), "WaterParams");
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(shader->getID(), blockIndex, PARAMS_BINDING);
+        }
+        m_paramsProgram = shader->getID();
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, PARAMS_BINDING, m_paramsUBO);
 }
 
-float WaterSurface::calculateGerstnerHeight(float x, float z, float time) const {
+float WaterSurface::getWaterHeight(float x, float z, float time) const {
     float height = 0.0f;
+    getWaterHeights(&x, &z, 1, time, &height);
+    return height;
+}
+
+void WaterSurface::getWaterHeights(const float* xs, const float* zs, int count, float time,
+                                   float* outHeights, glm::vec3* outNormals, glm::vec2* outDisplacements,
+                                   glm::vec3* outVelocities) const {
+    // FFT 模式：对与渲染相同的纹理数据做平铺双线性采样
+    if (m_waveModel == WaveModel::FFT_OCEAN && m_ocean) {
+        m_ocean->sample(xs, zs, count, outHeights, outNormals, outDisplacements, outVelocities);
+        for (int i = 0; i < count; ++i) {
+            outHeights[i] += m_baseHeight;
+        }
+        return;
+    }
+    
+    // 只要高度且缓存对应同一时刻：范围内插值，范围外的点再统一精确计算
+    bool useCache = m_heightfield.isValid() && time == m_heightfield.getTime()
+                    && !outNormals && !outDisplacements && !outVelocities;
+    if (!useCache) {
+        sampleGerstner(xs, zs, count, time, outHeights, outNormals, outDisplacements, outVelocities);
+    } else {
+        std::vector<int> missed;
+        for (int i = 0; i < count; ++i) {
+            if (!m_heightfield.sample(xs[i], zs[i], outHeights[i])) {
+                missed.push_back(i);
+            }
+        }
+        if (!missed.empty()) {
+            std::vector<float> missXs(missed.size()), missZs(missed.size()), missHeights(missed.size());
+            for (size_t j = 0; j < missed.size(); ++j) {
+                missXs[j] = xs[missed[j]];
+                missZs[j] = zs[missed[j]];
+            }
+            sampleGerstner(missXs.data(), missZs.data(), static_cast<int>(missed.size()), time,
+                           missHeights.data());
+            for (size_t j = 0; j < missed.size(); ++j) {
+                outHeights[missed[j]] = missHeights[j];
+            }
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        outHeights[i] += m_baseHeight;
+    }
+}
+
+void WaterSurface::setWaterRegions(const std::vector<unsigned char>& regionMap, int gridSize, float cellSize,
+                                   float originX, float originZ, const std::vector<WaterRegion>& regions) {
+    m_regions.assign(regions.begin(), regions.begin() + std::min(static_cast<int>(regions.size()), MAX_WAVE_SETS - 1));
+    m_wavesDirty = true;
+    m_heightfield.invalidate();
+    
+    if (m_regions.empty() || gridSize <= 0 || regionMap.size() < static_cast<size_t>(gridSize * gridSize)) {
+        m_regions.clear();
+        m_regionMap.clear();
+        return;
+    }
+    
+    bool resized = (m_regionTexture == 0 || gridSize != m_regionGridSize);
+    m_regionMap = regionMap;
+    m_regionGridSize = gridSize;
+    m_regionCellSize = cellSize;
+    m_regionOrigin = glm::vec2(originX, originZ);
+    
+    if (m_regionTexture == 0) {
+        glGenTextures(1, &m_regionTexture);
+    }
+    glBindTexture(GL_TEXTURE_2D, m_regionTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (resized) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, gridSize, gridSize, 0, GL_RED, GL_UNSIGNED_BYTE, regionMap.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, gridSize, gridSize, GL_RED, GL_UNSIGNED_BYTE, regionMap.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+int WaterSurface::getWaveSetAt(float x, float z) const {
+    if (m_regionMap.empty()) return 0;
+    
+    // 与 water.vert 的 waveSetAt 相同：取最近格点周围 4 个格子中的水域（8 邻接标记保证至多一个）
+    int cornerX = static_cast<int>(std::floor((x - m_regionOrigin.x) / m_regionCellSize + 0.5f));
+    int cornerZ = static_cast<int>(std::floor((z - m_regionOrigin.y) / m_regionCellSize + 0.5f));
+    int set = 0;
+    for (int dz = -1; dz <= 0; ++dz) {
+        for (int dx = -1; dx <= 0; ++dx) {
+            int cellX = std::min(std::max(cornerX + dx, 0), m_regionGridSize - 1);
+            int cellZ = std::min(std::max(cornerZ + dz, 0), m_regionGridSize - 1);
+            set = std::max(set, static_cast<int>(m_regionMap[cellZ * m_regionGridSize + cellX]));
+        }
+    }
+    if (set != 0) return set;
     
-    for (const auto& wave : m_waves) {
-        float k = 2.0f * glm::pi<float>() / wave.wavelength;
-        float c = wave.speed;
-        float d_dot_p = wave.direction.x * x + wave.direction.y * z;
-        float phase = k * d_dot_p - c * time;
+    // 落在岸上（如船体采样点越过岸边）时按包围盒归到附近的水域
+    for (size_t i = 0; i < m_regions.size(); ++i) {
+        const WaterRegion& region = m_regions[i];
+        if (x >= region.boundsMin.x && x <= region.boundsMax.x && z >= region.boundsMin.y && z <= region.boundsMax.y) {
+            return static_cast<int>(i) + 1;
+        }
+    }
+    return 0;
+}
+
+const GerstnerWave* WaterSurface::getWaveSet(int set, int& outCount) const {
+    if (set > 0 && set <= static_cast<int>(m_regions.size())) {
+        const std::vector<GerstnerWave>& waves = m_regions[set - 1].waves;
+        outCount = std::min(static_cast<int>(waves.size()), 4);
+        return waves.data();
+    }
+    // 与 render 一致，最多 4 个波参与计算
+    outCount = (set == 0) ? std::min(static_cast<int>(m_waves.size()), 4) : 0;
+    return m_waves.data();
+}
+
+void WaterSurface::sampleGerstner(const float* xs, const float* zs, int count, float time,
+                                  float* outHeights, glm::vec3* outNormals, glm::vec2* outDisplacements,
+                                  glm::vec3* outVelocities) const {
+    int waveCount = 0;
+    if (m_regionMap.empty()) {
+        const GerstnerWave* waves = getWaveSet(0, waveCount);
+        GerstnerSampler::sample(waves, waveCount, time, xs, zs, count,
+                                outHeights, outNormals, outDisplacements, outVelocities);
+        return;
+    }
+    
+    std::vector<int> sets(count, 0);
+    bool singleSet = true;
+    for (int i = 0; i < count; ++i) {
+        sets[i] = getWaveSetAt(xs[i], zs[i]);
+        singleSet = singleSet && sets[i] == sets[0];
+    }
+    
+    // 常见情况：所有点在同一水域，直接整批采样
+    if (count == 0 || singleSet) {
+        const GerstnerWave* waves = getWaveSet(count > 0 ? sets[0] : 0, waveCount);
+        GerstnerSampler::sample(waves, waveCount, time, xs, zs, count,
+                                outHeights, outNormals, outDisplacements, outVelocities);
+        return;
+    }
+    
+    // 跨水域：按波浪组收集、批量采样后写回
+    std::vector<bool> done(count, false);
+    std::vector<int> members;
+    std::vector<float> groupXs, groupZs, groupHeights;
+    std::vector<glm::vec3> groupNormals, groupVelocities;
+    std::vector<glm::vec2> groupDisplacements;
+    for (int first = 0; first < count; ++first) {
+        if (done[first]) continue;
+        members.clear();
+        groupXs.clear();
+        groupZs.clear();
+        for (int i = first; i < count; ++i) {
+            if (done[i] || sets[i] != sets[first]) continue;
+            done[i] = true;
+            members.push_back(i);
+            groupXs.push_back(xs[i]);
+            groupZs.push_back(zs[i]);
+        }
         
-        // Gerstner Wave 高度公式
-        height += wave.amplitude * std::sin(phase);
+        const int groupCount = static_cast<int>(members.size());
+        groupHeights.resize(groupCount);
+        groupNormals.resize(outNormals ? groupCount : 0);
+        groupDisplacements.resize(outDisplacements ? groupCount : 0);
+        groupVelocities.resize(outVelocities ? groupCount : 0);
+        const GerstnerWave* waves = getWaveSet(sets[first], waveCount);
+        GerstnerSampler::sample(waves, waveCount, time, groupXs.data(), groupZs.data(), groupCount,
+                                groupHeights.data(),
+                                outNormals ? groupNormals.data() : nullptr,
+                                outDisplacements ? groupDisplacements.data() : nullptr,
+                                outVelocities ? groupVelocities.data() : nullptr);
+        for (int j = 0; j < groupCount; ++j) {
+            outHeights[members[j]] = groupHeights[j];
+            if (outNormals) outNormals[members[j]] = groupNormals[j];
+            if (outDisplacements) outDisplacements[members[j]] = groupDisplacements[j];
+            if (outVelocities) outVelocities[members[j]] = groupVelocities[j];
+        }
+    }
+}
+
+void WaterSurface::setHeightfieldEnabled(bool enabled) {
+    m_heightfieldEnabled = enabled;
+    m_heightfield.invalidate();
+    if (!enabled) {
+        m_heightfield.release();
+    }
+}
+
+float WaterSurface::getMinWavelength() const {
+    float minWavelength = 0.0f;
+    auto consider = [&](const std::vector<GerstnerWave>& waves) {
+        for (const GerstnerWave& wave : waves) {
+            if (wave.amplitude <= 0.0f) continue;
+            if (minWavelength == 0.0f || wave.wavelength < minWavelength) {
+                minWavelength = wave.wavelength;
+            }
+        }
+    };
+    consider(m_waves);
+    for (const WaterRegion& region : m_regions) {
+        consider(region.waves);
+    }
+    return minWavelength;
+}
+
+void WaterSurface::updateHeightfield(float time, const std::vector<glm::vec2>& focusPoints, float margin) {
+    if (!m_heightfieldEnabled || m_waveModel == WaveModel::FFT_OCEAN) return;
+    m_heightfield.invalidate();
+    
+    float minWavelength = getMinWavelength();
+    if (minWavelength <= 0.0f) return;
+    
+    // 覆盖范围：整个水面，或所有关注点外扩 margin 后的包围盒（裁剪到水面内）
+    glm::vec2 surfaceMin(m_centerX - m_width / 2.0f, m_centerZ - m_height / 2.0f);
+    glm::vec2 surfaceMax(m_centerX + m_width / 2.0f, m_centerZ + m_height / 2.0f);
+    glm::vec2 areaMin = surfaceMin;
+    glm::vec2 areaMax = surfaceMax;
+    if (!focusPoints.empty()) {
+        areaMin = focusPoints[0];
+        areaMax = focusPoints[0];
+        for (const glm::vec2& p : focusPoints) {
+            areaMin = glm::min(areaMin, p);
+            areaMax = glm::max(areaMax, p);
+        }
+        areaMin = glm::max(areaMin - glm::vec2(margin), surfaceMin);
+        areaMax = glm::min(areaMax + glm::vec2(margin), surfaceMax);
+        if (areaMin.x >= areaMax.x || areaMin.y >= areaMax.y) {
+            return;
+        }
     }
     
-    return height;
+    m_heightfield.build(areaMin, areaMax, WaveHeightfield::spacingForWavelength(minWavelength), time,
+                        [&](const float* xs, const float* zs, int count, float* outHeights) {
+                            sampleGerstner(xs, zs, count, time, outHeights);
+                        });
 }
 
 void WaterSurface::setWaveParameters(int waveCount, float amplitude, float wavelength, float speed) {
     m_waves.clear();
+    m_heightfield.invalidate();
+    m_wavesDirty = true;
     
     // 生成多个不同方向的波浪
     for (int i = 0; i < waveCount; ++i) {
         float angle = (2.0f * glm::pi<float>() * i) / waveCount;
-        WaveParams wave;
+        GerstnerWave wave;
         wave.direction = glm::normalize(glm::vec2(std::cos(angle), std::sin(angle)));
         wave.amplitude = amplitude * (1.0f - i * 0.2f);  // 逐渐减小
         wave.wavelength = wavelength * (1.0f + i * 0.3f);
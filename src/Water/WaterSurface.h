@@ -3,6 +3,12 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <vector>
+#include "WaterPatchPool.h"
+#include "WaterClipmap.h"
+#include "GerstnerSampler.h"
+#include "OceanSpectrum.h"
+#include "WakeSimulation.h"
+#include "WaveHeightfield.h"
 
 namespace WaterTown {
 
@@ -14,6 +20,14 @@ class Camera;
  */
 class WaterSurface {
 public:
+    /**
+     * @brief 波浪模型
+     */
+    enum class WaveModel {
+        GERSTNER,   // m_waves 中最多 4 个 Gerstner 波叠加（着色器内解析计算）
+        FFT_OCEAN   // 海浪谱 + CPU 逆 FFT，结果以位移/法线纹理平铺到整个水面
+    };
+    
     /**
      * @brief 构造函数
      * @param centerX 水面中心 X 坐标
@@ -54,21 +68,180 @@ public:
                  glm::vec2 boatHalfExtentsXZ = glm::vec2(0.0f),
                  float boatCutoutFeather = 0.0f);
 
+    /**
+     * @brief 推进波浪到 time 时刻（每个模拟步调用一次，在物理查询之前）
+     *
+     * FFT 模式下做一次逆 FFT 并上传位移/法线纹理，之后的 getWaterHeight 与渲染都使用这一帧的结果；
+     * Gerstner 模式下为解析计算，无需更新。
+     */
+    void update(float time);
+    
+    /**
+     * @brief 切换波浪模型（首次切到 FFT 时才创建海浪谱和纹理）
+     */
+    void setWaveModel(WaveModel model);
+    WaveModel getWaveModel() const { return m_waveModel; }
+    
+    /**
+     * @brief 启用/关闭船只尾迹模拟（首次启用时创建）
+     */
+    void setWakeEnabled(bool enabled);
+    bool isWakeEnabled() const { return m_wakeEnabled; }
+    
+    /**
+     * @brief 尾迹模拟（未创建时为 nullptr）
+     */
+    const WakeSimulation* getWake() const { return m_wake; }
+    
+    /**
+     * @brief 以船只为中心推进尾迹模拟并上传高度纹理（未启用时什么也不做）
+     * @param deltaTime 本帧时长（秒）
+     * @param boatPos 船只中心 XZ
+     * @param boatForward 船头方向 XZ（单位向量）
+     * @param boatSpeed 船速（米/秒，倒车为负）
+     * @param boatLength 船长
+     * @param boatWidth 船宽
+     */
+    void updateWake(float deltaTime, const glm::vec2& boatPos, const glm::vec2& boatForward,
+                    float boatSpeed, float boatLength, float boatWidth);
+    
     /**
      * @brief 更新水面网格（用于自定义形状的水面）
      * @param vertices 顶点数据 (x, y, z, u, v) x N
+     * @param indices 三角形索引，为空时按非索引三角形列表绘制
+     */
+    void updateMesh(const std::vector<float>& vertices,
+                    const std::vector<unsigned int>& indices = std::vector<unsigned int>());
+    
+    /**
+     * @brief 改用分块缓冲绘制水面，由调用方通过 getPatchPool() 填充并按块增量更新
+     */
+    void usePatchPool();
+    
+    /**
+     * @brief 水面分块缓冲（仅在 usePatchPool() 之后参与绘制）
+     */
+    WaterPatchPool& getPatchPool() { return m_patchPool; }
+    
+    /**
+     * @brief 规则网格改用跟随相机的嵌套 LOD 网格（自定义网格/分块缓冲不受影响）
+     *
+     * 近处间距为 baseSpacing，每向外一层翻倍，层数保证以水面内任意位置为中心都能覆盖整个水面。
+     * @param enabled 是否启用
+     * @param baseSpacing 最内层格子间距（世界坐标）
+     * @param gridSize 每层每边的格子数（4 的倍数）
+     */
+    void setClipmapEnabled(bool enabled, float baseSpacing = 0.5f, int gridSize = 40);
+    bool isClipmapEnabled() const { return m_clipmapEnabled; }
+    
+    /**
+     * @brief 丢弃自定义网格，恢复构造时的规则网格
+     */
+    void resetMesh();
+    
+    /**
+     * @brief 波浪位移所需的最大顶点间距（与规则网格的间距一致）
+     */
+    float getMaxVertexSpacing() const { return m_width / m_resolution; }
+    
+    /**
+     * @brief 上传整张逐格水域遮罩（非水格子在片元着色器中丢弃，网格保持规则网格不变）
+     * @param mask 每格 1 字节，按 z * gridSize + x 排列，非 0 表示水
+     * @param gridSize 网格边长（格子数）
+     * @param cellSize 格子边长（世界坐标）
+     * @param originX 网格 (0,0) 角的世界 X 坐标
+     * @param originZ 网格 (0,0) 角的世界 Z 坐标
+     */
+    void setWaterMask(const std::vector<unsigned char>& mask, int gridSize, float cellSize,
+                      float originX, float originZ);
+    
+    /**
+     * @brief 更新遮罩的一个矩形区域（一次 glTexSubImage2D）
+     * @param data width * height 字节，按行排列，非 0 表示水
      */
-    void updateMesh(const std::vector<float>& vertices);
+    void setWaterMaskRegion(int gridX, int gridZ, int width, int height, const unsigned char* data);
     
     /**
-     * @brief 获取指定位置的水面高度（用于船只浮力计算）
+     * @brief 获取指定位置的水面高度（用于船只浮力计算，已考虑 water.vert 的水平位移）
      * @param x 世界坐标 X
      * @param z 世界坐标 Z
-     * @param time 当前时间
+     * @param time 当前时间（FFT 模式下忽略，使用最近一次 update 的结果）
      * @return 该位置的水面高度（Y 坐标）
      */
     float getWaterHeight(float x, float z, float time) const;
     
+    /**
+     * @brief 批量获取水面高度（SIMD，适合大量漂浮物/采样点一起查询）
+     * @param xs 采样点世界 X 坐标
+     * @param zs 采样点世界 Z 坐标
+     * @param count 采样点数量
+     * @param time 当前时间
+     * @param outHeights 输出水面高度（Y 坐标，含基准高度）
+     * @param outNormals 可选，输出水面单位法线
+     * @param outDisplacements 可选，输出该处水面质点的水平位移 XZ
+     * @param outVelocities 可选，输出该处水面质点的速度
+     */
+    void getWaterHeights(const float* xs, const float* zs, int count, float time,
+                         float* outHeights,
+                         glm::vec3* outNormals = nullptr,
+                         glm::vec2* outDisplacements = nullptr,
+                         glm::vec3* outVelocities = nullptr) const;
+    
+    /**
+     * @brief 启用/关闭物理查询用的波浪高度场缓存
+     *
+     * 启用后每个模拟步调用一次 updateHeightfield，把波浪和预先算到关注点周围的规则网格上，
+     * 同一时刻、落在缓存范围内的高度查询改为 Catmull-Rom 插值（见 WaveHeightfield）。
+     * 网格间距随当前最短波长变化。
+     */
+    void setHeightfieldEnabled(bool enabled);
+    bool isHeightfieldEnabled() const { return m_heightfieldEnabled; }
+    
+    /**
+     * @brief 按当前时刻重新计算高度场（多线程），未启用时什么也不做
+     * FFT 模式本身就是查表，不需要该缓存，此时什么也不做。
+     * @param time 本模拟步的时间，之后相同时间的查询才会命中缓存
+     * @param focusPoints 需要覆盖的位置（如船只），为空时覆盖整个水面
+     * @param margin 每个关注点周围的覆盖半径（世界坐标）
+     */
+    void updateHeightfield(float time, const std::vector<glm::vec2>& focusPoints, float margin);
+    
+    /**
+     * @brief water.vert / water.frag 中 WaterParams uniform 块使用的绑定点
+     */
+    static const unsigned int PARAMS_BINDING = 1;
+    
+    /**
+     * @brief 波浪组上限：第 0 组为默认波浪，其余每个水域一组（与 water.vert 中 uWaves 的大小一致）
+     */
+    static const int MAX_WAVE_SETS = 16;
+    
+    /**
+     * @brief 一片独立水域（如池塘、河道）：包围盒与自己的波浪组
+     */
+    struct WaterRegion {
+        glm::vec2 boundsMin; // XZ
+        glm::vec2 boundsMax; // XZ
+        std::vector<GerstnerWave> waves; // 最多 4 个
+    };
+    
+    /**
+     * @brief 设置各水域的波浪组与逐格水域编号
+     * @param regionMap 逐格水域编号（行优先，gridSize x gridSize），0 表示使用默认波浪，k 对应 regions[k - 1]
+     * @param gridSize 网格大小
+     * @param cellSize 格子大小
+     * @param originX 网格原点 X（世界坐标）
+     * @param originZ 网格原点 Z（世界坐标）
+     * @param regions 水域列表（最多 MAX_WAVE_SETS - 1 个），为空时所有水面使用默认波浪
+     */
+    void setWaterRegions(const std::vector<unsigned char>& regionMap, int gridSize, float cellSize,
+                         float originX, float originZ, const std::vector<WaterRegion>& regions);
+    
+    /**
+     * @brief 默认波浪组（未归入任何水域的水面使用）
+     */
+    const std::vector<GerstnerWave>& getWaves() const { return m_waves; }
+    
     /**
      * @brief 设置波浪参数
      * @param waveCount 波浪数量（1-4）
@@ -94,6 +267,17 @@ private:
     int m_vertexCount;
     int m_indexCount;
     bool m_useCustomMesh; // 是否使用自定义网格
+    bool m_customIndexed; // 自定义网格是否带索引
+    bool m_usePatchPool;  // 是否使用分块缓冲绘制
+    WaterPatchPool m_patchPool;
+    bool m_clipmapEnabled; // 规则网格是否改用 LOD 网格
+    WaterClipmap m_clipmap;
+    
+    // 逐格水域遮罩（R8 纹理，一个纹素对应一个地形格子）
+    unsigned int m_maskTexture;
+    int m_maskGridSize;
+    float m_maskCellSize;
+    glm::vec2 m_maskOrigin;
     
     // 水面参数
     float m_centerX, m_centerZ;
@@ -102,24 +286,100 @@ private:
     int m_resolution;
     
     // Gerstner Waves 参数
-    struct WaveParams {
-        glm::vec2 direction;  // 波浪方向
-        float amplitude;      // 振幅
-        float wavelength;     // 波长
-        float speed;          // 速度
-        float steepness;      // 陡峭度
+    std::vector<GerstnerWave> m_waves;
+    
+    // 多水域：逐格水域编号（CPU 副本与 R8 纹理），编号 k 的水域使用第 k 组波浪
+    std::vector<WaterRegion> m_regions;
+    std::vector<unsigned char> m_regionMap;
+    unsigned int m_regionTexture;
+    int m_regionGridSize;
+    float m_regionCellSize;
+    glm::vec2 m_regionOrigin;
+    
+    /**
+     * @brief WaterParams uniform 块的 CPU 镜像（std140 布局，填充字段显式写出，便于整体比较）
+     */
+    struct ParamsBlock {
+        struct Wave {
+            float direction[2];
+            float amplitude;
+            float wavelength;
+            float speed;
+            float steepness;
+            float padding[2];
+        } waves[MAX_WAVE_SETS * 4]; // 第 k 组占 [4k, 4k + 4)
+        int waveCounts[MAX_WAVE_SETS];
+        int useBoatCutout;
+        int boatCutoutShape;
+        float boatCutoutInner;
+        float boatCutoutOuter;
+        float waterColor[3];
+        float boatCutoutFeather;
+        float lightDir[3];
+        float padding0;
+        float boatPos[3];
+        float padding1;
+        float boatForwardXZ[2];
+        float boatHalfExtentsXZ[2];
     };
-    std::vector<WaveParams> m_waves;
+    
+    // 波浪/颜色/光照/船只裁剪参数的 uniform 缓冲，内容变化时才重新上传
+    unsigned int m_paramsUBO;
+    unsigned int m_paramsProgram; // 已设置过块绑定的着色器程序
+    ParamsBlock m_params;         // 最近一次上传的内容
+    bool m_wavesDirty;            // m_waves 改变后需要重新写入 m_params
+    
+    // 船只尾迹（按需创建），在 water.vert 中叠加到波浪位移上
+    bool m_wakeEnabled;
+    WakeSimulation* m_wake;
+    unsigned int m_wakeTexture; // R32F 高度
+    
+    // FFT 海浪（按需创建）
+    WaveModel m_waveModel;
+    OceanSpectrum* m_ocean;
+    unsigned int m_oceanDisplacementTexture; // RGBA32F：(dx, h, dz, 0)
+    unsigned int m_oceanNormalTexture;       // RGBA32F：(nx, ny, nz, 0)
+    
+    // 波浪高度场缓存（相对基准面的高度）
+    bool m_heightfieldEnabled;
+    WaveHeightfield m_heightfield;
     
     /**
-     * @brief 生成水面网格
+     * @brief 默认波浪与各水域波浪组中最短的波长
      */
-    void generateMesh();
+    float getMinWavelength() const;
+    
+    /**
+     * @brief 点 (x, z) 所在水域的波浪组编号（0 为默认波浪）
+     */
+    int getWaveSetAt(float x, float z) const;
+    
+    /**
+     * @brief 第 set 组波浪及其数量（最多 4 个）
+     */
+    const GerstnerWave* getWaveSet(int set, int& outCount) const;
     
     /**
-     * @brief 计算 Gerstner Wave 在指定点的高度
+     * @brief 按各点所在水域的波浪组批量计算 Gerstner 波（参数同 GerstnerSampler::sample）
      */
-    float calculateGerstnerHeight(float x, float z, float time) const;
+    void sampleGerstner(const float* xs, const float* zs, int count, float time,
+                        float* outHeights, glm::vec3* outNormals = nullptr,
+                        glm::vec2* outDisplacements = nullptr, glm::vec3* outVelocities = nullptr) const;
+    
+    /**
+     * @brief 与上次上传的内容不同时更新 uniform 缓冲，并绑定到 PARAMS_BINDING
+     */
+    void uploadParams(Shader* shader, const ParamsBlock& params);
+    
+    /**
+     * @brief 把海浪位移/法线上传到纹理（首次创建，之后 glTexSubImage2D）
+     */
+    void uploadOceanTextures();
+    
+    /**
+     * @brief 生成水面网格
+     */
+    void generateMesh();
 };
 
 } // namespace WaterTown
@@ -0,0 +1,85 @@
+#include "WaveHeightfield.h"
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WaterTown {
+
+namespace {
+
+// 一维 Catmull-Rom：p1 与 p2 之间按 t 插值
+inline float catmullRom(float p0, float p1, float p2, float p3, float t) {
+    return p1 + 0.5f * t * (p2 - p0 + t * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3
+                                       + t * (3.0f * (p1 - p2) + p3 - p0)));
+}
+
+} // namespace
+
+WaveHeightfield::WaveHeightfield()
+    : m_valid(false), m_time(0.0f), m_spacing(1.0f), m_origin(0.0f), m_cols(0), m_rows(0) {
+}
+
+void WaveHeightfield::build(const glm::vec2& areaMin, const glm::vec2& areaMax, float spacing, float time,
+                            const RowSampler& sampler) {
+    // 原点对齐到间距的整数倍，跟随船只移动时采样点位置不变，插值结果不会抖动；
+    // 两侧各多一个采样点，范围边缘处也有完整的 4x4 邻域
+    m_spacing = spacing;
+    m_origin = (glm::floor(areaMin / spacing) - 1.0f) * spacing;
+    m_cols = static_cast<int>(std::ceil((areaMax.x - m_origin.x) / spacing)) + 3;
+    m_rows = static_cast<int>(std::ceil((areaMax.y - m_origin.y) / spacing)) + 3;
+
+    const int cols = m_cols;
+    const size_t sampleCount = static_cast<size_t>(cols) * m_rows;
+    m_heights.resize(sampleCount);
+    m_zs.resize(sampleCount);
+    m_xs.resize(cols);
+    for (int col = 0; col < cols; ++col) {
+        m_xs[col] = m_origin.x + col * spacing;
+    }
+
+    // 每行一个任务，行内交给批量采样
+    ThreadPool::getInstance().parallelFor(m_rows, [&](int row) {
+        float* rowZs = &m_zs[static_cast<size_t>(row) * cols];
+        std::fill(rowZs, rowZs + cols, m_origin.y + row * spacing);
+        sampler(m_xs.data(), rowZs, cols, &m_heights[static_cast<size_t>(row) * cols]);
+    });
+
+    m_time = time;
+    m_valid = true;
+}
+
+bool WaveHeightfield::sample(float x, float z, float& outHeight) const {
+    if (!m_valid) return false;
+
+    float fx = (x - m_origin.x) / m_spacing;
+    float fz = (z - m_origin.y) / m_spacing;
+    if (!(fx >= 1.0f && fz >= 1.0f)) return false;
+
+    int col = static_cast<int>(fx);
+    int row = static_cast<int>(fz);
+    if (col + 2 >= m_cols || row + 2 >= m_rows) return false;
+
+    float tx = fx - col;
+    float tz = fz - row;
+    float rowHeights[4];
+    for (int j = 0; j < 4; ++j) {
+        const float* r = &m_heights[static_cast<size_t>(row - 1 + j) * m_cols + col - 1];
+        rowHeights[j] = catmullRom(r[0], r[1], r[2], r[3], tx);
+    }
+    outHeight = catmullRom(rowHeights[0], rowHeights[1], rowHeights[2], rowHeights[3], tz);
+    return true;
+}
+
+void WaveHeightfield::release() {
+    m_valid = false;
+    m_cols = 0;
+    m_rows = 0;
+    m_heights.clear();
+    m_heights.shrink_to_fit();
+    m_xs.clear();
+    m_xs.shrink_to_fit();
+    m_zs.clear();
+    m_zs.shrink_to_fit();
+}
+
+} // namespace WaterTown
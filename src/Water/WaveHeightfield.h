@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 某一时刻的水面高度网格（纯 CPU，不依赖 OpenGL），供同一模拟步内的物理查询插值
+ *
+ * 行按任务分给线程池，行内交给调用方的批量采样函数（SIMD）。
+ * 查询用 Catmull-Rom 双三次插值：间距取最短波长的 1/SAMPLES_PER_WAVELENGTH 时，
+ * 默认波浪下与直接求值的高度差约 1 mm（双线性插值同样间距下约 1.3 cm）。
+ */
+class WaveHeightfield {
+public:
+    /**
+     * @brief 每个最短波长内的采样数
+     */
+    static constexpr float SAMPLES_PER_WAVELENGTH = 8.0f;
+
+    /**
+     * @brief 批量采样一行：(xs[i], zs[i]) 处相对基准面的高度写入 outHeights[i]
+     */
+    using RowSampler = std::function<void(const float* xs, const float* zs, int count, float* outHeights)>;
+
+    WaveHeightfield();
+
+    /**
+     * @brief 按最短波长得到网格间距
+     */
+    static float spacingForWavelength(float minWavelength) { return minWavelength / SAMPLES_PER_WAVELENGTH; }
+
+    /**
+     * @brief 计算覆盖 [areaMin, areaMax] 的网格（多线程），外扩一圈供双三次插值使用
+     * 缓冲区只增不减，范围随船只变化时不重新分配。
+     * @param spacing 网格间距（世界坐标）
+     * @param time 本模拟步的时间，记录下来供调用方判断缓存是否对应同一时刻
+     * @param sampler 批量采样函数，会在多个线程上同时调用
+     */
+    void build(const glm::vec2& areaMin, const glm::vec2& areaMax, float spacing, float time,
+               const RowSampler& sampler);
+
+    /**
+     * @brief 插值 (x, z) 处的高度，点不在网格范围内（或网格无效）时返回 false
+     */
+    bool sample(float x, float z, float& outHeight) const;
+
+    /**
+     * @brief 标记失效（波浪参数变化等），下次 build 前的查询都不命中
+     */
+    void invalidate() { m_valid = false; }
+
+    /**
+     * @brief 失效并释放缓冲
+     */
+    void release();
+
+    bool isValid() const { return m_valid; }
+    float getTime() const { return m_time; }
+    float getSpacing() const { return m_spacing; }
+    int getSampleCount() const { return m_cols * m_rows; }
+
+private:
+    bool m_valid;
+    float m_time;
+    float m_spacing;
+    glm::vec2 m_origin;
+    int m_cols, m_rows;
+    std::vector<float> m_heights; // 行优先
+    std::vector<float> m_xs;      // 一行的采样 x 坐标
+    std::vector<float> m_zs;      // 每个采样点的 z 坐标（按行填充）
+};
+
+} // namespace WaterTown
@@ -1,5 +1,7 @@
 #include "Core/Application.h"
 #include "Render/Shader.h"
+#include "Render/FrameUniforms.h"
+#include "Render/RenderState.h"
 #include "Render/Camera.h"
 #include "Render/BoatRenderer.h"
 #include "Render/TerrainRenderer.h"
@@ -27,7 +29,7 @@ protected:
         std::cout << "Initializing WaterTown App..." << std::endl;
         
         // 启用深度测试
-        glEnable(GL_DEPTH_TEST);
+        RenderState::enable(GL_DEPTH_TEST);
         
         // 创建立方体顶点数据（位置 + 法线）
         createCubeData();
@@ -37,10 +39,19 @@ protected:
         m_waterShader = new Shader("assets/shaders/water.vert", "assets/shaders/water.frag");
         m_grassShader = new Shader("assets/shaders/grass.vert", "assets/shaders/grass.frag");
         m_stoneShader = new Shader("assets/shaders/stone.vert", "assets/shaders/stone.frag");
+        m_terrainShader = new Shader("assets/shaders/terrain.vert", "assets/shaders/basic.frag");
+        m_brickShader = new Shader("assets/shaders/brick.vert", "assets/shaders/basic.frag");
+        m_objectShader = new Shader("assets/shaders/object.vert", "assets/shaders/basic.frag");
+        
+        // 所有着色器共用的相机/光源参数
+        m_frameUniforms = new FrameUniforms();
+        m_frameUniforms->setLight(glm::vec3(10.0f, 50.0f, 10.0f), glm::vec3(1.0f, 1.0f, 1.0f));
         
         // 创建水面
         m_waterSurface = new WaterSurface(0.0f, 0.0f, 160.0f, 160.0f, 100); // 320 * 0.5 = 160
         m_waterSurface->setBaseHeight(SceneEditor::WATER_LEVEL);  // 水面高度
+        m_waterSurface->setClipmapEnabled(true);                   // 近处 0.5m、远处逐层翻倍的 LOD 网格
+        m_waterSurface->setWakeEnabled(true);                      // 船只尾迹
         
         // 创建场景编辑器
         m_sceneEditor = new SceneEditor();
@@ -250,6 +261,12 @@ protected:
     void onRender() override {
         if (!m_shader || !m_camera) return;
         
+        // GL 状态缓存从本帧开始重新跟踪（统计面板显示上一帧的计数）
+        RenderState::beginFrame();
+        
+        // 每帧更新一次相机/光源 uniform 块，各渲染器共用
+        m_frameUniforms->update(m_camera);
+        
         // === 旋转立方体已注释 ===
         // m_shader->use();
         // glm::mat4 model = glm::mat4(1.0f);
@@ -273,7 +290,12 @@ protected:
         if (m_sceneEditor && m_terrainRenderer) {
             if (m_sceneEditor->getCurrentMode() == EditorMode::TERRAIN) {
                 // 地形编辑模式：使用纯色着色器渲染所有地形
-                m_terrainRenderer->render(m_sceneEditor, m_shader, m_camera);
+                if (m_terrainShader) {
+                    m_terrainRenderer->render(m_sceneEditor, m_terrainShader, m_camera);
+                }
+                if (m_brickShader) {
+                    m_terrainRenderer->renderBankWalls(m_sceneEditor, m_brickShader, m_camera);
+                }
             } else {
                 // 建筑/游戏模式：分类型使用独立着色器渲染
                 if (m_grassShader) {
@@ -286,13 +308,13 @@ protected:
         }
         
         // === 渲染放置的物体(所有模式) ===
-        if (m_sceneEditor && m_objectRenderer && m_shader) {
+        if (m_sceneEditor && m_objectRenderer && m_objectShader) {
             m_objectRenderer->clear();
             const auto& objects = m_sceneEditor->getPlacedObjects();
             for (const auto& obj : objects) {
                 m_objectRenderer->addObject(obj.first, obj.second);
             }
-            m_objectRenderer->render(m_shader, m_camera);
+            m_objectRenderer->render(m_objectShader, m_camera);
         }
         
         // === 渲染水面(仅在非地形编辑模式) ===
@@ -332,8 +354,8 @@ protected:
         
         // 清理资源
         if (m_cubeVAO) {
-            glDeleteVertexArrays(1, &m_cubeVAO);
-            glDeleteBuffers(1, &m_cubeVBO);
+            RenderState::deleteVertexArrays(1, &m_cubeVAO);
+            RenderState::deleteBuffers(1, &m_cubeVBO);
         }
         
         delete m_shader;
@@ -341,6 +363,9 @@ protected:
         delete m_terrainShader;
         delete m_grassShader;
         delete m_stoneShader;
+        delete m_brickShader;
+        delete m_objectShader;
+        delete m_frameUniforms;
         delete m_waterSurface;
         delete m_sceneEditor;
         delete m_editorUI;
@@ -358,6 +383,9 @@ private:
     Shader* m_terrainShader = nullptr;
     Shader* m_grassShader = nullptr;
     Shader* m_stoneShader = nullptr;
+    Shader* m_brickShader = nullptr;
+    Shader* m_objectShader = nullptr;
+    FrameUniforms* m_frameUniforms = nullptr;
     WaterSurface* m_waterSurface = nullptr;
     SceneEditor* m_sceneEditor = nullptr;
     EditorUI* m_editorUI = nullptr;
@@ -430,9 +458,9 @@ private:
         glGenVertexArrays(1, &m_cubeVAO);
         glGenBuffers(1, &m_cubeVBO);
         
-        glBindVertexArray(m_cubeVAO);
+        RenderState::bindVertexArray(m_cubeVAO);
         
-        glBindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
+        RenderState::bindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         
         // 位置属性
@@ -443,7 +471,7 @@ private:
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(1);
         
-        glBindVertexArray(0);
+        RenderState::bindVertexArray(0);
         
         std::cout << "Cube VAO/VBO created successfully." << std::endl;
     }